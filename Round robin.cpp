@@ -1,5 +1,6 @@
 #include <iostream>
     #include <iomanip>
+    #include <vector>
     using namespace std;
 
     // Main function - Round Robin Scheduling Simulator
@@ -7,14 +8,25 @@
         // =============== VARIABLE DECLARATIONS ===============
         int n, i, completed = 0;                              // n=number of processes, i=counter, completed=finished count
         float current_time = 0, tq;                           // current_time=CPU clock, tq=time quantum
-        float at[100], bt[100], rt[100], tat[100], wt[100];  // Arrival Time, Burst Time, Remaining Time, Turnaround Time, Waiting Time
-        int gantt_process[500], gantt_count = 0;             // Gantt chart: process IDs and count
-        float gantt_start[500], gantt_end[500];              // Gantt chart: start and end times
+        vector<float> at, bt, rt, tat, wt;                   // Arrival Time, Burst Time, Remaining Time, Turnaround Time, Waiting Time
+        vector<int> gantt_process;                           // Gantt chart: process IDs
+        vector<float> gantt_start, gantt_end;                // Gantt chart: start and end times
         float tatavg = 0, wtavg = 0;                         // Sums for average calculations
 
         // =============== INPUT SECTION ===============
         cout << "Enter the number of processes: ";
         cin >> n;
+        if (n < 1) {
+            cout << "\nNumber of processes must be at least 1\n";
+            return 1;
+        }
+
+        // One entry per process, however many there are
+        at.resize(n);
+        bt.resize(n);
+        rt.resize(n);
+        tat.resize(n);
+        wt.resize(n);
 
         // Get arrival time and burst time for each process
         for (i = 0; i < n; i++) {
@@ -31,16 +43,32 @@
         cout << "\nEnter Time Quantum: ";
         cin >> tq;
 
+        // Processes that still need CPU time, in input order
+        // Finished ones are dropped after every cycle, so a cycle only visits
+        // unfinished processes instead of all n
+        vector<int> pending;
+        for (i = 0; i < n; i++) {
+            if (rt[i] > 0) {
+                pending.push_back(i);
+            } else {
+                // Nothing to run: done the moment it arrives
+                tat[i] = wt[i] = 0;
+                completed++;
+            }
+        }
+
         // =============== ROUND ROBIN SCHEDULING ALGORITHM ===============
         while (completed < n) {  // Continue until all processes finish
             int executed = 0;    // Flag: 0 if CPU is idle, 1 if process executes
+            size_t kept = 0;     // Unfinished processes kept for the next cycle
 
-            // Check each process to see if it can execute
-            for (i = 0; i < n; i++) {
+            // Check each unfinished process to see if it can execute
+            for (size_t k = 0; k < pending.size(); k++) {
+                i = pending[k];
                 // Check if process has arrived AND still needs CPU time
                 if (at[i] <= current_time && rt[i] > 0) {
-                    executed = 1;                  // Mark that CPU is not idle
-                    int start_time = current_time; // Record when process starts
+                    executed = 1;                    // Mark that CPU is not idle
+                    float start_time = current_time; // Record when process starts
 
                     // ========== EXECUTION LOGIC ==========
                     if (rt[i] > tq) {
@@ -64,16 +92,22 @@
                     }
 
                     // Store execution information for Gantt chart
-                    gantt_process[gantt_count] = i + 1;     // Process ID
-                    gantt_start[gantt_count] = start_time;  // When it started
-                    gantt_end[gantt_count] = current_time;  // When it ended
-                    gantt_count++;                          // Increment step count
+                    gantt_process.push_back(i + 1);     // Process ID
+                    gantt_start.push_back(start_time);  // When it started
+                    gantt_end.push_back(current_time);  // When it ended
                 }
+                // Keep it for the next cycle if it still needs CPU time
+                if (rt[i] > 0) pending[kept++] = i;
             }
+            pending.resize(kept);
 
-            // If no process executed this cycle, CPU is idle - advance time
+            // If no process executed this cycle, CPU is idle - jump straight
+            // to the earliest arrival among the processes still waiting
             if (!executed) {
-                current_time++;
+                current_time = at[pending[0]];
+                for (size_t k = 1; k < pending.size(); k++) {
+                    if (at[pending[k]] < current_time) current_time = at[pending[k]];
+                }
             }
         }
 
@@ -102,18 +136,19 @@
         
         // Show which processes executed
         cout << "Processes: ";
-        for (i = 0; i < gantt_count; i++) {
+        for (i = 0; i < (int)gantt_process.size(); i++) {
             cout << "| P" << gantt_process[i] << " ";
         }
         cout << "|\n";
 
         // Show timeline (time values with decimals)
         cout << "Time:      ";
-        for (i = 0; i < gantt_count; i++) {
+        for (i = 0; i < (int)gantt_start.size(); i++) {
             cout << fixed << setprecision(2) << gantt_start[i];  // Show decimals
             cout << "    ";                                      // Space for readability
         }
-        cout << fixed << setprecision(2) << gantt_end[gantt_count - 1] << "\n";  // Final end time
+        // Final end time (every burst may have been zero)
+        cout << fixed << setprecision(2) << (gantt_end.empty() ? current_time : gantt_end.back()) << "\n";
 
         return 0;
     }
\ No newline at end of file
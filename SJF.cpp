@@ -1,73 +1,227 @@
 #include <iostream>          // For input and output
-#include <iomanip>           // For setting width and precision
+#include <charconv>          // For fast number parsing and formatting
+#include <cstdint>           // For fixed-width integer types
+#include <cstdio>            // For reading piped input in one go
+#include <cstring>           // For memcpy
+#include <functional>        // For greater (min-heap order)
+#include <queue>             // For the ready queue in arrival mode
+#include <string>            // For the command line flag
+#include <tuple>             // For ready queue entries
+#include <vector>            // For heap-allocated arrays of any size
+#include <unistd.h>          // For isatty
+#include "scheduling_output.h"  // For OutputBuffer (buffered output)
 using namespace std;         // Use standard namespace
 
-int main() {
-    int n;                   // Variable to store number of processes
-    cout << "\nEnter number of processes: ";  // Ask user for number of processes
-    cin >> n;                // Read number of processes
+// Sort key of a float: its bits, reordered so that comparing the keys as
+// unsigned integers gives the same order as comparing the floats
+uint32_t floatKey(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof bits);                  // Reinterpret the float's bits
+    // Negative floats: flip every bit; positive floats: flip the sign bit
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
 
-    float burstTime[n];      // Array to store burst time for each process
-    float waitingTime[n], turnaroundTime[n];  // Arrays for waiting and turnaround times
-    int process[n];          // Array to store process numbers
+// Process indices 0..n-1 ordered by value (lower index first on ties)
+// LSD radix sort: three stable passes of 11 bits over the 32-bit keys, so the
+// cost is linear in n instead of the n^2 of an exchange sort
+vector<int> sortedOrder(const vector<float>& value) {
+    size_t n = value.size();                            // Number of entries
+    // Entry: key in the high 32 bits, index in the low 32 bits
+    vector<uint64_t> entries(n), scratch(n);
+    for (size_t i = 0; i < n; i++) {                    // Pack every key with its index
+        entries[i] = (uint64_t(floatKey(value[i])) << 32) | i;
+    }
+    for (int shift = 32; shift < 64; shift += 11) {     // One pass per 11-bit digit
+        size_t count[2048] = {};                        // Entries per digit value
+        for (uint64_t e : entries) count[(e >> shift) & 2047]++;
+        size_t position = 0;                            // Start of each digit's run
+        for (size_t& c : count) {
+            size_t run = c;
+            c = position;
+            position += run;
+        }
+        for (uint64_t e : entries) scratch[count[(e >> shift) & 2047]++] = e;  // Stable scatter
+        entries.swap(scratch);
+    }
+    vector<int> order(n);                               // Indices in sorted order
+    for (size_t i = 0; i < n; i++) order[i] = int(entries[i] & 0xFFFFFFFFu);
+    return order;
+}
 
-    // Input burst times manually from the user
-    for (int i = 0; i < n; i++) {           // Loop through each process
-        process[i] = i + 1;                 // Assign process number (P1, P2, P3...)
-        cout << "Enter burst time for process " << (i + 1) << " -- ";  // Ask for burst time
-        cin >> burstTime[i];                // Read and store burst time
+// Reads the numbers typed by the user
+// From a terminal every number is read as it is typed; piped input is read in
+// one go and parsed in place, which is much faster for millions of processes
+class NumberReader {
+public:
+    NumberReader() : piped(!isatty(0)) {
+        if (!piped) return;
+        size_t got;                                     // Bytes read by the last call
+        char block[1 << 16];                            // Read in 64 KB blocks
+        while ((got = fread(block, 1, sizeof block, stdin)) > 0) text.insert(text.end(), block, block + got);
     }
 
-    // Sort by burst time using bubble sort (Shortest Job First)
-    for (int i = 0; i < n - 1; i++) {      // Outer loop for each position
-        for (int j = i + 1; j < n; j++) {  // Inner loop to compare elements
-            if (burstTime[i] > burstTime[j]) {  // If current is greater than next
-                swap(burstTime[i], burstTime[j]);  // Swap burst times
-                swap(process[i], process[j]);      // Swap process numbers to keep track
-            }
+    bool interactive() const { return !piped; }
+
+    // Read the next number into value; false if there is none
+    template <typename T>
+    bool read(T& value) {
+        if (!piped) return bool(cin >> value);
+        while (position < text.size() && isspace((unsigned char)text[position])) position++;  // Skip whitespace
+        const char* first = text.data() + position;
+        if (position < text.size() && *first == '+') first++;  // from_chars takes no '+'
+        from_chars_result r = from_chars(first, text.data() + text.size(), value);
+        if (r.ec != errc()) return false;
+        position = r.ptr - text.data();
+        return true;
+    }
+
+private:
+    bool piped;                                         // Input is a file or pipe, not a terminal
+    vector<char> text;                                  // Whole piped input
+    size_t position = 0;                                // Next unread byte of text
+};
+
+// Print value with two decimals, right-aligned in a field of width characters
+void putRight(OutputBuffer& out, double value, size_t width) {
+    char text[64];
+    size_t length = to_chars(text, text + sizeof text, value, chars_format::fixed, 2).ptr - text;
+    if (length < width) out.fill(' ', width - length);  // Pad on the left
+    out.put(text, length);
+}
+
+// Print text right-aligned in a field of width characters
+void putRight(OutputBuffer& out, const string& text, size_t width) {
+    if (text.size() < width) out.fill(' ', width - text.size());  // Pad on the left
+    out.put(text);
+}
+
+// Usage: SJF              burst times only (every process arrives at 0)
+//        SJF --arrival    also read an arrival time per process
+int main(int argc, char* argv[]) {
+    // Arrival mode if the flag was given
+    bool withArrival = argc > 1 && string(argv[1]) == "--arrival";
+    if (argc > 2 || (argc == 2 && !withArrival)) {
+        cerr << "Usage: " << argv[0] << " [--arrival]" << endl;  // Explain the only option
+        return 1;
+    }
+    NumberReader input;      // Numbers typed by the user
+    OutputBuffer out(stdout);  // Buffered output; flushed before the user types anything
+    // Ask a question: at a terminal the prompt must be shown before the answer is read
+    auto prompt = [&](const char* text, int process) {
+        out.put(text);
+        if (process > 0) {
+            out.putInt(process);
+            out.put(" -- ");
         }
+        if (input.interactive()) out.flush();
+    };
+
+    int n;                   // Variable to store number of processes
+    prompt("\nEnter number of processes: ", 0);  // Ask user for number of processes
+    if (!input.read(n) || n < 1) {  // Read number of processes
+        out.put("\nNumber of processes must be at least 1\n");
+        out.flush();
+        return 1;
     }
 
-    // Calculation for waiting time
-    waitingTime[0] = 0;     // First process has no waiting time
-    for (int i = 1; i < n; i++) {           // For all other processes
-        // Waiting time = previous waiting time + previous burst time
-        waitingTime[i] = waitingTime[i - 1] + burstTime[i - 1];
+    // Heap-allocated arrays, so any number of processes fits
+    vector<float> burstTime(n), arrivalTime(n, 0);          // Burst and arrival time per process
+    vector<double> waitingTime(n), turnaroundTime(n);       // Waiting and turnaround times (in run order)
+    vector<int> process(n);                                 // Process numbers in run order
+
+    // Input burst (and arrival) times manually from the user
+    for (int i = 0; i < n; i++) {           // Loop through each process
+        bool ok = true;                     // Every number could be read
+        if (withArrival) {
+            prompt("Enter arrival time for process ", i + 1);  // Ask for arrival time
+            ok = input.read(arrivalTime[i]);  // Read and store arrival time
+        }
+        prompt("Enter burst time for process ", i + 1);  // Ask for burst time
+        if (!ok || !input.read(burstTime[i])) {  // Read and store burst time
+            out.put("\nExpected a number\n");
+            out.flush();
+            return 1;
+        }
     }
 
-    // Calculation for turnaround time
-    for (int i = 0; i < n; i++) {           // For each process
-        // Turnaround time = waiting time + burst time (total time from arrival to completion)
-        turnaroundTime[i] = waitingTime[i] + burstTime[i];
+    // Run order (Shortest Job First), with sums kept in double so long runs
+    // do not drift
+    vector<float> runBurst(n), runArrival(n);               // Burst and arrival time in run order
+    if (!withArrival) {
+        // Everyone is ready at 0: run in burst order (lower process number first on ties)
+        vector<int> order = sortedOrder(burstTime);
+        double elapsed = 0;                 // Prefix sum of the bursts run so far
+        for (int i = 0; i < n; i++) {       // For each process in run order
+            int p = order[i];
+            process[i] = p + 1;             // Process number (P1, P2, P3...)
+            runBurst[i] = burstTime[p];
+            // Waiting time = sum of all bursts before it
+            waitingTime[i] = elapsed;
+            elapsed += burstTime[p];
+            // Turnaround time = waiting time + burst time (total time from arrival to completion)
+            turnaroundTime[i] = waitingTime[i] + burstTime[p];
+        }
+    } else {
+        // Arrived processes wait in a min-heap keyed on (burst, arrival, process)
+        vector<int> byArrival = sortedOrder(arrivalTime);
+        typedef tuple<float, float, int> Job;
+        priority_queue<Job, vector<Job>, greater<Job>> ready;
+        double currentTime = 0;             // CPU clock
+        int next = 0;                       // Next process to arrive, in arrival order
+        for (int i = 0; i < n; i++) {       // Pick one process per step
+            // If no process is waiting, jump to the next arrival time
+            if (ready.empty() && arrivalTime[byArrival[next]] > currentTime) currentTime = arrivalTime[byArrival[next]];
+            while (next < n && arrivalTime[byArrival[next]] <= currentTime) {  // Queue every arrived process
+                int p = byArrival[next++];
+                ready.push(make_tuple(burstTime[p], arrivalTime[p], p));
+            }
+            int p = get<2>(ready.top());    // Shortest waiting job
+            ready.pop();
+            process[i] = p + 1;
+            runBurst[i] = burstTime[p];
+            runArrival[i] = arrivalTime[p];
+            // Waiting time = start - arrival; turnaround time = completion - arrival
+            waitingTime[i] = currentTime - arrivalTime[p];
+            currentTime += burstTime[p];
+            turnaroundTime[i] = currentTime - arrivalTime[p];
+        }
     }
 
     // Calculate average waiting and turnaround times
-    float totalWaiting = 0, totalTurnaround = 0;  // Variables to store totals
+    double totalWaiting = 0, totalTurnaround = 0;  // Variables to store totals
     for (int i = 0; i < n; i++) {           // Add all times together
         totalWaiting += waitingTime[i];     // Add this process's waiting time
         totalTurnaround += turnaroundTime[i];  // Add this process's turnaround time
     }
 
     // Display the output
-    cout << "\n\n=== SJF (Shortest Job First) Scheduling ===\n";  // Print title
-    cout << fixed << setprecision(2);       // Set decimal places to 2
-    cout << left << setw(12) << "Process"   // Print "Process" column header
-         << right << setw(12) << "BT"       // Print "BT" (Burst Time) column header
-         << right << setw(12) << "WT"       // Print "WT" (Waiting Time) column header
-         << right << setw(12) << "TAT\n";   // Print "TAT" (Turnaround Time) column header
-    cout << string(48, '-') << endl;        // Print separator line
-
-    // Print each process with its values
+    out.put("\n\n=== SJF (Shortest Job First) Scheduling ===\n");  // Print title
+    size_t width = withArrival ? 60 : 48;   // Table width with or without the AT column
+    out.putPadded("Process", 12);           // Print "Process" column header
+    if (withArrival) putRight(out, "AT", 12);  // Print "AT" (Arrival Time) column header
+    putRight(out, "BT", 12);                // Print "BT" (Burst Time) column header
+    putRight(out, "WT", 12);                // Print "WT" (Waiting Time) column header
+    putRight(out, "TAT\n", 12);             // Print "TAT" (Turnaround Time) column header
+    out.fill('-', width);                   // Print separator line
+    out.put('\n');
+
+    // Print each process with its values, in the order they ran
     for (int i = 0; i < n; i++) {           // Loop through each process
-        cout << left << setw(12) << ("P" + to_string(process[i]))  // Print process name (P1, P2...)
-             << right << setw(12) << burstTime[i]                   // Print burst time
-             << right << setw(12) << waitingTime[i]                 // Print waiting time
-             << right << setw(12) << turnaroundTime[i] << endl;     // Print turnaround time
+        out.putPadded("P" + to_string(process[i]), 12);  // Print process name (P1, P2...)
+        if (withArrival) putRight(out, runArrival[i], 12);  // Print arrival time
+        putRight(out, runBurst[i], 12);     // Print burst time
+        putRight(out, waitingTime[i], 12);  // Print waiting time
+        putRight(out, turnaroundTime[i], 12);  // Print turnaround time
+        out.put('\n');
     }
 
-    cout << string(48, '-') << endl;        // Print separator line
-    cout << "\nAverage Waiting Time = " << totalWaiting / n;  // Calculate and print average waiting time
-    cout << "\nAverage Turnaround Time = " << totalTurnaround / n << endl;  // Calculate and print average turnaround time
+    out.fill('-', width);                   // Print separator line
+    out.put("\n\nAverage Waiting Time = ");
+    out.putFixed(totalWaiting / n, 2);      // Calculate and print average waiting time
+    out.put("\nAverage Turnaround Time = ");
+    out.putFixed(totalTurnaround / n, 2);   // Calculate and print average turnaround time
+    out.put('\n');
+    out.flush();             // Write everything still buffered
 
     return 0;               // End program successfully
 }
@@ -1,385 +1,449 @@
 #include <iostream>
 #include <vector>
-#include <algorithm>
-#include <queue>
 #include <iomanip>
-#include <cmath>
-#include <climits>
+#include <memory>
+#include "scheduling_core.h"
+#include "scheduling_trace.h"
+#include "scheduling_parallel.h"
+#include "scheduling_stats.h"
+#include "scheduling_sketch.h"
+#include "scheduling_output.h"
+#include "scheduling_multicore.h"
+#include "scheduling_whatif.h"
+#include "scheduling_workload.h"
 // Use standard namespace
 using namespace std;
 
-// Process structure to hold process information
-struct Process {
-    int pid;                    // Process ID - unique identifier for each process
-    int arrival_time;          // AT - time when process arrives in queue
-    int burst_time;            // BT - total CPU time needed for process
-    int remaining_time;        // Remaining time - CPU time still needed
-    int completion_time;       // CT - time when process finishes execution
-    int turnaround_time;       // TAT - completion time minus arrival time
-    int waiting_time;          // WT - turnaround time minus burst time
-    bool completed;            // Flag to mark if process is completed
-};
-
 // Function to display the scheduling table with results
-void displayTable(vector<Process>& processes, string algorithm_name) {
-    // Print a separator line
+// Rows go through a buffered writer, so large traces are not slowed down by
+// per-row stream formatting and flushes
+// decimals is the fixed-point resolution of the times (0 for whole units)
+template <typename Time>
+void displayTable(const BasicProcessView<Time>& table, const BasicScheduleResult<Time>& result, string algorithm_name,
+                  int decimals = 0) {
+    OutputBuffer out(stdout);
+    ResultWriter(out, OutputFormat::Table, decimals).write(table, result, algorithm_name);
+    out.flush();
+}
+
+// Function to display context switch accounting for one run
+template <typename Time>
+void displayOverhead(const BasicProcessView<Time>& table, const BasicScheduleResult<Time>& result, int decimals = 0) {
+    // Print how many switches happened and how much time they cost
+    cout << "Context Switches: " << result.context_switches << endl;
+    cout << "Switch Overhead: " << formatTicks(result.switch_overhead, decimals) << endl;
+    // Print the share of the busy span spent on real work
+    cout << "CPU Utilization: " << fixed << setprecision(2) << 100 * result.cpuUtilization(table) << "%" << endl;
+}
+
+// Function to display tail latency and fairness of one run
+void displayStats(const ProcessView& table, const ScheduleResult& result) {
+    ScheduleStats stats = scheduleStats(table, result);
+    // Print the table headers with fixed width columns
+    cout << "\n" << left << setw(8) << "" 
+         << setw(10) << "Min" 
+         << setw(10) << "P50" 
+         << setw(10) << "P95" 
+         << setw(10) << "P99" 
+         << setw(10) << "Max" 
+         << setw(12) << "Mean" 
+         << "Std Dev" << endl;
+    // Print one row for waiting time and one for turnaround time
+    for (const auto& row : {make_pair("WT", &stats.waiting), make_pair("TAT", &stats.turnaround)}) {
+        const ColumnStats& column = *row.second;
+        cout << left << setw(8) << row.first 
+             << setw(10) << column.min 
+             << setw(10) << column.p50 
+             << setw(10) << column.p95 
+             << setw(10) << column.p99 
+             << setw(10) << column.max 
+             << setw(12) << fixed << setprecision(2) << column.mean 
+             << column.stddev << endl;
+    }
+    // Print Jain's index over per-job slowdown (1.00 = perfectly fair)
+    cout << "Fairness (Jain's index of TAT/BT): " << fixed << setprecision(4) << stats.fairness << endl;
+}
+
+// Function to display the aggregates of a streaming run, which keeps no
+// per-process rows to print
+void displayStreaming(const StreamingStats& stats, const ScheduleResult& result, string algorithm_name,
+                      bool show_overhead) {
+    // Print the algorithm name between separator lines
     cout << "\n" << string(80, '=') << endl;
-    // Print the algorithm name
     cout << "Algorithm: " << algorithm_name << endl;
-    // Print another separator line
     cout << string(80, '=') << endl;
-    
+    cout << "Processes: " << stats.waiting.count() << endl;
     // Print the table headers with fixed width columns
-    cout << left << setw(8) << "PID" 
-         << setw(8) << "AT" 
-         << setw(8) << "BT" 
-         << setw(12) << "CT" 
-         << setw(8) << "TAT" 
-         << setw(8) << "WT" << endl;
+    cout << "\n" << left << setw(8) << "" 
+         << setw(10) << "Min" 
+         << setw(10) << "P50" 
+         << setw(10) << "P95" 
+         << setw(10) << "P99" 
+         << setw(10) << "Max" 
+         << "Mean" << endl;
+    // One row per sketch: waiting, turnaround and response time
+    for (const auto& row : {make_pair("WT", &stats.waiting), make_pair("TAT", &stats.turnaround),
+                            make_pair("RT", &stats.response)}) {
+        const QuantileSketch& sketch = *row.second;
+        cout << left << setw(8) << row.first 
+             << setw(10) << sketch.min() 
+             << setw(10) << sketch.quantile(50) 
+             << setw(10) << sketch.quantile(95) 
+             << setw(10) << sketch.quantile(99) 
+             << setw(10) << sketch.max() 
+             << fixed << setprecision(2) << sketch.mean() << endl;
+    }
+    // Print Jain's index over per-job slowdown and the sketch accuracy
+    cout << "Fairness (Jain's index of TAT/BT): " << fixed << setprecision(4) << stats.fairness() << endl;
+    cout << "Percentile Error: within " << setprecision(2) << 100 * stats.waiting.relativeError() << "%" << endl;
+    if (show_overhead) {
+        // Same accounting as displayOverhead, from the streamed aggregates
+        cout << "Context Switches: " << result.context_switches << endl;
+        cout << "Switch Overhead: " << result.switch_overhead << endl;
+        cout << "CPU Utilization: " << fixed << setprecision(2) << 100 * stats.cpuUtilization() << "%" << endl;
+    }
+}
+
+// Function to display per-core statistics of a multi-core run
+void displayCores(const MulticoreResult& result) {
+    // Print the table headers with fixed width columns
+    cout << "\n" << left << setw(8) << "Core" 
+         << setw(12) << "Busy" 
+         << setw(12) << "Jobs" 
+         << setw(12) << "Stolen" 
+         << "Utilization" << endl;
+    // Loop through each simulated core
+    for (size_t c = 0; c < result.busy_time.size(); c++) {
+        cout << left << setw(8) << c 
+             << setw(12) << result.busy_time[c] 
+             << setw(12) << result.completed[c] 
+             << setw(12) << result.stolen[c] 
+             << fixed << setprecision(2) << 100 * result.utilization(c) << "%" << endl;
+    }
+    // Print how far the busiest core is above the average
+    cout << "Load Imbalance (max/mean busy): " << fixed << setprecision(2) << result.imbalance() << endl;
+}
+
+// Function to display per-level statistics of a feedback queue run
+template <typename Time>
+void displayLevels(const BasicScheduleResult<Time>& result, int decimals = 0) {
+    // Print the table headers with fixed width columns
+    cout << "\n" << left << setw(8) << "Level" 
+         << setw(10) << "Quantum" 
+         << setw(12) << "Slices" 
+         << setw(12) << "CPU Time" 
+         << setw(10) << "Done" 
+         << setw(10) << "Demoted" 
+         << setw(10) << "Preempted" 
+         << setw(8) << "Boosted" << endl;
     // Print a separator line under headers
     cout << string(80, '-') << endl;
-    
-    // Initialize variables to accumulate total waiting time and turnaround time
-    double total_wt = 0, total_tt = 0;
-    
-    // Loop through each process to display its data
-    for (const auto& p : processes) {
-        // Print process data in formatted columns
-        cout << left << setw(8) << p.pid 
-             << setw(8) << p.arrival_time 
-             << setw(8) << p.burst_time 
-             << setw(12) << p.completion_time 
-             << setw(8) << p.turnaround_time 
-             << setw(8) << p.waiting_time << endl;
-        // Add to total waiting time
-        total_wt += p.waiting_time;
-        // Add to total turnaround time
-        total_tt += p.turnaround_time;
+    // Print one row per level, top level first
+    for (size_t l = 0; l < result.levels.size(); l++) {
+        const LevelStats& level = result.levels[l];
+        cout << left << setw(8) << l 
+             << setw(10) << formatTicks(level.quantum, decimals) 
+             << setw(12) << level.dispatches 
+             << setw(12) << formatTicks(level.run_time, decimals) 
+             << setw(10) << level.completions 
+             << setw(10) << level.demotions 
+             << setw(10) << level.preemptions 
+             << setw(8) << level.boosts << endl;
     }
-    
-    // Print separator line
-    cout << string(80, '-') << endl;
-    // Calculate and print average waiting time
-    cout << "Average WT: " << fixed << setprecision(2) << (total_wt / processes.size()) << endl;
-    // Calculate and print average turnaround time
-    cout << "Average TT: " << fixed << setprecision(2) << (total_tt / processes.size()) << endl;
 }
 
-// Shortest Job First (SJF) - Non-preemptive scheduling algorithm
-void sjf(vector<Process>& processes) {
-    // Create a temporary copy of processes for manipulation
-    vector<Process> temp = processes;
-    // Sort processes by arrival time, then by burst time (for tie-breaking)
-    sort(temp.begin(), temp.end(), [](const Process& a, const Process& b) {
-        // If arrival times are different, sort by arrival time
-        if (a.arrival_time != b.arrival_time)
-            return a.arrival_time < b.arrival_time;
-        // Otherwise, sort by burst time
-        return a.burst_time < b.burst_time;
-    });
+// Function to display a Gantt chart, one cell per segment plus idle gaps
+template <typename Time>
+void displayGantt(const BasicGanttChart<Time>& gantt, int decimals = 0) {
+    // Print the chart title
+    cout << "\nGantt Chart:" << endl;
+    // Build the process row and the time row together so the cells line up
+    string processes_row = "Processes: ", time_row = "Time:      ";
+    // End of the previous segment, to detect idle gaps
+    Time previous_end = gantt.segments.empty() ? 0 : gantt.segments[0].start;
+    // Add one cell (a label above its start time) to both rows
+    auto add_cell = [&](const string& label, Time start) {
+        string cell = "| " + label + " ";
+        string time = formatTicks(start, decimals);
+        // Make the cell wide enough for both the label and the time
+        size_t width = max(cell.size(), time.size() + 1);
+        processes_row += cell + string(width - cell.size(), ' ');
+        time_row += time + string(width - time.size(), ' ');
+    };
+    // Loop through each recorded segment
+    for (const auto& segment : gantt.segments) {
+        // Show CPU idle time between segments
+        if (segment.start > previous_end) add_cell("--", previous_end);
+        // Show the process that ran, or CS for a context switch
+        add_cell(segment.pid == GANTT_SWITCH ? "CS" : "P" + to_string(segment.pid), segment.start);
+        previous_end = segment.end;
+    }
+    // Close the chart with the final end time
+    cout << processes_row << "|" << endl;
+    cout << time_row << formatTicks(previous_end, decimals) << endl;
+}
+
+// Function to display a Round Robin quantum sweep and compare it with the
+// median/mean heuristics
+void displaySweep(const ProcessView& table, const vector<QuantumPoint>& points, int switch_cost) {
+    // Print the sweep title between separator lines
+    cout << "\n" << string(80, '=') << endl;
+    cout << "Round Robin Quantum Sweep (* = Pareto-optimal over WT, TAT, switches)" << endl;
+    cout << string(80, '=') << endl;
     
-    // Initialize current time to 0
-    int current_time = 0;
-    // Track which processes have been executed
-    vector<bool> executed(temp.size(), false);
+    // Print the table headers with fixed width columns
+    cout << left << setw(10) << "Quantum" 
+         << setw(14) << "Avg WT" 
+         << setw(14) << "Avg TAT" 
+         << setw(12) << "Switches" 
+         << setw(12) << "CPU Util" 
+         << "Pareto" << endl;
+    cout << string(80, '-') << endl;
     
-    // Loop through all processes
-    for (int i = 0; i < temp.size(); i++) {
-        // Initialize index to -1 (not found)
-        int idx = -1;
-        // Initialize minimum burst time to maximum value
-        int min_burst = INT_MAX;
-        
-        // Find process with minimum burst time that has arrived
-        for (int j = 0; j < temp.size(); j++) {
-            // Check if process hasn't been executed AND has arrived AND has minimum burst time
-            if (!executed[j] && temp[j].arrival_time <= current_time && temp[j].burst_time < min_burst) {
-                // Update minimum burst time
-                min_burst = temp[j].burst_time;
-                // Update index to current process
-                idx = j;
-            }
-        }
-        
-        // If no process available, jump to next arrival time
-        if (idx == -1) {
-            // Search for next unexecuted process
-            for (int j = 0; j < temp.size(); j++) {
-                // If process hasn't been executed
-                if (!executed[j]) {
-                    // Set current time to this process's arrival time
-                    current_time = temp[j].arrival_time;
-                    // Set index to this process
-                    idx = j;
-                    // Exit loop
-                    break;
-                }
-            }
-        }
-        
-        // Mark process as executed
-        executed[idx] = true;
-        // Add burst time to current time
-        current_time += temp[idx].burst_time;
-        // Set completion time
-        temp[idx].completion_time = current_time;
-        // Calculate turnaround time (completion - arrival)
-        temp[idx].turnaround_time = temp[idx].completion_time - temp[idx].arrival_time;
-        // Calculate waiting time (turnaround - burst)
-        temp[idx].waiting_time = temp[idx].turnaround_time - temp[idx].burst_time;
+    // Track the quantum with the lowest average waiting time
+    const QuantumPoint* best = &points[0];
+    // Print one row per simulated quantum
+    for (const auto& p : points) {
+        cout << left << setw(10) << p.quantum 
+             << setw(14) << fixed << setprecision(2) << p.average_waiting 
+             << setw(14) << p.average_turnaround 
+             << setw(12) << p.context_switches 
+             << setw(12) << to_string(int(100 * p.cpu_utilization + 0.5)) + "%" 
+             << (p.pareto ? "*" : "") << endl;
+        if (p.average_waiting < best->average_waiting) best = &p;
     }
+    cout << string(80, '-') << endl;
     
-    // Sort back to original PID order for display
-    sort(temp.begin(), temp.end(), [](const Process& a, const Process& b) {
-        // Sort by process ID in ascending order
-        return a.pid < b.pid;
-    });
-    
-    // Display the scheduling results
-    displayTable(temp, "Shortest Job First (SJF)");
+    // Print the empirical best next to what each heuristic would have picked
+    cout << "Best Avg WT:      quantum " << best->quantum << " (Avg WT " << best->average_waiting 
+         << ", Avg TAT " << best->average_turnaround << ", switches " << best->context_switches << ")" << endl;
+    int heuristics[2] = {calculateOptimalQuantum(table), calculateMeanQuantum(table)};
+    const char* labels[2] = {"Median heuristic: ", "Mean heuristic:   "};
+    for (int h = 0; h < 2; h++) {
+        // Simulate the heuristic quantum even if it lies outside the sweep range
+        ScheduleResult result = roundRobin(table, heuristics[h], nullptr, switch_cost);
+        cout << labels[h] << "quantum " << heuristics[h] << " (Avg WT " << result.averageWaiting() 
+             << ", Avg TAT " << result.averageTurnaround() << ", switches " << result.context_switches << ")" << endl;
+    }
 }
 
-// Shortest Remaining Time First (SRTF) - Preemptive scheduling algorithm
-void srtf(vector<Process>& processes) {
-    // Create a temporary copy of processes
-    vector<Process> temp = processes;
-    // Initialize current time to 0
-    int current_time = 0;
-    // Initialize completed process counter
-    int completed = 0;
-    // Store total number of processes
-    int n = temp.size();
+// Function to display how one changed or inserted job alters a schedule
+void displayWhatIf(const WhatIfDiff& diff, string algorithm_name) {
+    // Print the title between separator lines
+    cout << "\n" << string(80, '=') << endl;
+    cout << "What-if: " << algorithm_name << endl;
+    cout << string(80, '=') << endl;
     
-    // Loop until all processes are completed
-    while (completed < n) {
-        // Initialize index to -1 (not found)
-        int idx = -1;
-        // Initialize minimum remaining time to maximum value
-        int min_remaining = INT_MAX;
-        
-        // Find process with minimum remaining time that has arrived
-        for (int i = 0; i < n; i++) {
-            // Check if process has remaining time AND has arrived
-            if (temp[i].remaining_time > 0 && temp[i].arrival_time <= current_time) {
-                // If this process has less remaining time
-                if (temp[i].remaining_time < min_remaining) {
-                    // Update minimum remaining time
-                    min_remaining = temp[i].remaining_time;
-                    // Update index to current process
-                    idx = i;
-                }
-            }
-        }
-        
-        // If no process available, jump to next arrival time
-        if (idx == -1) {
-            // Initialize next arrival to maximum value
-            int next_arrival = INT_MAX;
-            // Search for next arriving process
-            for (int i = 0; i < n; i++) {
-                // If process still has work AND hasn't arrived yet
-                if (temp[i].remaining_time > 0 && temp[i].arrival_time > current_time) {
-                    // Update next arrival time to minimum
-                    next_arrival = min(next_arrival, temp[i].arrival_time);
-                }
-            }
-            // Jump to next arrival time
-            current_time = next_arrival;
-            // Skip to next iteration
-            continue;
-        }
-        
-        // Execute process for 1 unit of time
-        temp[idx].remaining_time--;
-        // Increment current time
-        current_time++;
-        
-        // If process is now complete
-        if (temp[idx].remaining_time == 0) {
-            // Set completion time
-            temp[idx].completion_time = current_time;
-            // Calculate turnaround time (completion - arrival)
-            temp[idx].turnaround_time = temp[idx].completion_time - temp[idx].arrival_time;
-            // Calculate waiting time (turnaround - burst)
-            temp[idx].waiting_time = temp[idx].turnaround_time - temp[idx].burst_time;
-            // Increment completed counter
-            completed++;
-        }
+    // Print the table headers: every value is shown before -> after
+    cout << left << setw(8) << "PID" 
+         << setw(24) << "CT" 
+         << setw(24) << "TAT" 
+         << "WT" << endl;
+    cout << string(80, '-') << endl;
+    // Print the changed job first, then every job it moved
+    for (const auto& row : diff.rows) {
+        string pid = to_string(row.pid) + (row.inserted ? " (new)" : "");
+        auto change = [&](int before, int after) {
+            return row.inserted ? "- -> " + to_string(after) : to_string(before) + " -> " + to_string(after);
+        };
+        cout << left << setw(8) << pid 
+             << setw(24) << change(row.completion_before, row.completion_after) 
+             << setw(24) << change(row.turnaround_before, row.turnaround_after) 
+             << change(row.waiting_before, row.waiting_after) << endl;
     }
+    cout << string(80, '-') << endl;
     
-    // Sort back to original PID order for display
-    sort(temp.begin(), temp.end(), [](const Process& a, const Process& b) {
-        // Sort by process ID in ascending order
-        return a.pid < b.pid;
-    });
-    
-    // Display the scheduling results
-    displayTable(temp, "Shortest Remaining Time First (SRTF)");
+    // Print the averages and switch counts before and after
+    cout << fixed << setprecision(2);
+    cout << "Average WT: " << diff.average_waiting_before << " -> " << diff.average_waiting_after << endl;
+    cout << "Average TT: " << diff.average_turnaround_before << " -> " << diff.average_turnaround_after << endl;
+    cout << "Context Switches: " << diff.context_switches_before << " -> " << diff.context_switches_after << endl;
+    // Print how much of the schedule had to be simulated again
+    cout << "Replayed " << diff.replayed_steps << " dispatches (the original run had " << diff.total_steps 
+         << ") from time " << diff.resumed_at;
+    if (diff.converged_at >= 0) cout << ", back in step with the original at time " << diff.converged_at << endl;
+    else cout << " to the end" << endl;
 }
 
-// Round Robin (RR) scheduling algorithm with time quantum
-void roundRobin(vector<Process>& processes, int quantum) {
-    // Create a temporary copy of processes
-    vector<Process> temp = processes;
-    // Initialize current time to 0
-    int current_time = 0;
-    // Create a queue to hold process indices
-    queue<int> rr_queue;
-    // Track which processes have been added to queue
-    vector<bool> added(temp.size(), false);
-    // Store total number of processes
-    int n = temp.size();
-    // Initialize completed process counter
-    int completed = 0;
-    
-    // Find the minimum arrival time
-    int min_arrival = INT_MAX;
-    // Loop through all processes
-    for (const auto& p : temp) {
-        // Find minimum arrival time
-        min_arrival = min(min_arrival, p.arrival_time);
-    }
-    // Set current time to first arrival
-    current_time = min_arrival;
-    
-    // Add initial processes that have arrived
-    for (int i = 0; i < n; i++) {
-        // If process has arrived by current time
-        if (temp[i].arrival_time <= current_time) {
-            // Add process to queue
-            rr_queue.push(i);
-            // Mark as added
-            added[i] = true;
-        }
+// Function to write per-process results in a machine-readable format, to
+// output_path or standard output; returns the exit code
+template <typename Time>
+int writeResults(const BasicProcessView<Time>& view, const vector<BasicScheduleResult<Time>>& results,
+                 const vector<string>& names, OutputFormat format, const string& output_path, int decimals = 0) {
+    FILE* file = output_path.empty() ? stdout : fopen(output_path.c_str(), "wb");
+    if (!file) {
+        cerr << "Error: cannot create " << output_path << endl;
+        return 1;
     }
-    
-    // Loop until all processes are completed
-    while (completed < n) {
-        // If queue is empty
-        if (rr_queue.empty()) {
-            // Find next arriving process
-            int next_arrival = INT_MAX;
-            // Search for next unscheduled process
-            for (int i = 0; i < n; i++) {
-                // If process hasn't been added yet
-                if (!added[i]) {
-                    // Update next arrival time
-                    next_arrival = min(next_arrival, temp[i].arrival_time);
-                }
-            }
-            // Jump to next arrival time
-            current_time = next_arrival;
-            // Add newly arrived processes
-            for (int i = 0; i < n; i++) {
-                // If process hasn't been added AND has arrived
-                if (!added[i] && temp[i].arrival_time <= current_time) {
-                    // Add process to queue
-                    rr_queue.push(i);
-                    // Mark as added
-                    added[i] = true;
-                }
-            }
-        }
-        
-        // Get front process from queue
-        int idx = rr_queue.front();
-        // Remove from front of queue
-        rr_queue.pop();
-        
-        // Calculate execution time (minimum of quantum and remaining time)
-        int execute_time = min(quantum, temp[idx].remaining_time);
-        // Add execution time to current time
-        current_time += execute_time;
-        // Reduce remaining time by execution time
-        temp[idx].remaining_time -= execute_time;
-        
-        // Add newly arrived processes
-        for (int i = 0; i < n; i++) {
-            // If process hasn't been added AND has arrived
-            if (!added[i] && temp[i].arrival_time <= current_time) {
-                // Add process to queue
-                rr_queue.push(i);
-                // Mark as added
-                added[i] = true;
-            }
-        }
-        
-        // If process still has remaining time
-        if (temp[idx].remaining_time > 0) {
-            // Add process back to end of queue
-            rr_queue.push(idx);
+    try {
+        OutputBuffer out(file);
+        ResultWriter writer(out, format, decimals);
+        for (size_t i = 0; i < results.size(); i++) writer.write(view, results[i], names[i]);
+        out.flush();
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    if (file != stdout && fclose(file) != 0) {
+        cerr << "Error: cannot write " << output_path << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Options of a fixed-point run, all times in whole units as given on the
+// command line (-1 / 0 mean the same defaults as the integer mode)
+struct FixedPointOptions {
+    int decimals = 2;
+    unsigned threads = 0;
+    int switch_cost = -1;
+    int mlfq_levels = 3;
+    int boost = 0;
+    int aging = -1;
+    bool show_gantt = false;
+    OutputFormat format = OutputFormat::Table;
+    string output_path;
+};
+
+// Function to run the selected policies on a fixed-point table, where every
+// time is a count of 10^-decimals ticks
+// The same engines as the integer mode, instantiated on int64_t, so
+// fractional bursts are scheduled exactly instead of through float sums
+int runFixedPoint(const BasicProcessView<int64_t>& view, const vector<string>& policy_names,
+                  const FixedPointOptions& options) {
+    int decimals = options.decimals;
+    int64_t unit = ticksPerUnit(decimals);
+    // Median burst rounded to a whole quantum, as in the integer mode
+    int64_t quantum = max<int64_t>(llround(double(calculateOptimalQuantum<int64_t>(view)) / unit), 1) * unit;
+    int64_t switch_cost = int64_t(max(options.switch_cost, 0)) * unit;
+    int64_t aging = options.aging < 0 ? quantum : options.aging * unit;
+    // MLFQ slices double on every level, boost defaults to ten bottom slices
+    vector<int64_t> quanta;
+    for (int l = 0; l < options.mlfq_levels; l++) quanta.push_back(quantum << min(l, 20));
+    int64_t boost = options.boost > 0 ? options.boost * unit : 10 * quanta.back();
+
+    // Display name of each policy, with its times in units
+    vector<string> names;
+    for (const auto& name : policy_names) {
+        if (name == "fcfs") names.push_back("First Come First Served (FCFS)");
+        else if (name == "sjf") names.push_back("Shortest Job First (SJF)");
+        else if (name == "srtf") names.push_back("Shortest Remaining Time First (SRTF)");
+        else if (name == "rr") names.push_back("Round Robin (RR) - Quantum: " + formatTicks(quantum, decimals));
+        else if (name == "mlfq") {
+            string list;
+            for (int64_t q : quanta) list += (list.empty() ? "" : "/") + formatTicks(q, decimals);
+            names.push_back("Multilevel Feedback Queue (MLFQ) - Quanta: " + list + ", Boost: " + formatTicks(boost, decimals));
+        } else if (name == "priority" || name == "ppriority") {
+            names.push_back(string("Priority (") + (name == "ppriority" ? "Preemptive" : "Non-preemptive") + ") - Aging: " +
+                            (aging > 0 ? formatTicks(aging, decimals) : "off"));
         } else {
-            // Set completion time
-            temp[idx].completion_time = current_time;
-            // Calculate turnaround time (completion - arrival)
-            temp[idx].turnaround_time = temp[idx].completion_time - temp[idx].arrival_time;
-            // Calculate waiting time (turnaround - burst)
-            temp[idx].waiting_time = temp[idx].turnaround_time - temp[idx].burst_time;
-            // Increment completed counter
-            completed++;
+            cerr << "Error: unknown policy '" << name << "'" << endl;
+            return 1;
         }
     }
-    
-    // Sort back to original PID order for display
-    sort(temp.begin(), temp.end(), [](const Process& a, const Process& b) {
-        // Sort by process ID in ascending order
-        return a.pid < b.pid;
-    });
-    
-    // Display the scheduling results with quantum time
-    displayTable(temp, "Round Robin (RR) - Quantum: " + to_string(quantum));
-}
 
-// Calculate optimal quantum time using median of burst times
-int calculateOptimalQuantum(vector<Process>& processes) {
-    // Create a vector to store burst times
-    vector<int> burst_times;
-    // Loop through all processes
-    for (const auto& p : processes) {
-        // Add burst time to vector
-        burst_times.push_back(p.burst_time);
-    }
-    // Sort burst times in ascending order
-    sort(burst_times.begin(), burst_times.end());
-    
-    // Store the size of burst times vector
-    int n = burst_times.size();
-    // Declare median variable
-    double median;
-    // If number of elements is even
-    if (n % 2 == 0) {
-        // Median is average of two middle elements
-        median = (burst_times[n/2 - 1] + burst_times[n/2]) / 2.0;
-    } else {
-        // If odd, median is the middle element
-        median = burst_times[n/2];
+    // Run all policies concurrently, each with its own Gantt chart
+    ThreadPool pool(options.threads);
+    vector<BasicGanttChart<int64_t>> gantts(policy_names.size());
+    vector<future<BasicScheduleResult<int64_t>>> pending;
+    for (size_t i = 0; i < policy_names.size(); i++) {
+        string name = policy_names[i];
+        BasicGanttChart<int64_t>* gantt = options.show_gantt ? &gantts[i] : nullptr;
+        pending.push_back(pool.submit([=, &view] {
+            if (name == "fcfs") return fcfs<int64_t>(view, gantt, switch_cost);
+            if (name == "sjf") return sjf<int64_t>(view, gantt, switch_cost);
+            if (name == "srtf") return srtf<int64_t>(view, gantt, switch_cost);
+            if (name == "rr") return roundRobin<int64_t>(view, quantum, gantt, switch_cost);
+            if (name == "mlfq") return feedbackQueue<int64_t>(view, quanta, boost, gantt, switch_cost);
+            return priorityScheduling<int64_t>(view, name == "ppriority", aging, gantt, switch_cost);
+        }));
     }
-    
-    // Round median to nearest integer
-    int quantum = round(median);
-    // Return quantum (at least 1 to avoid division by zero)
-    return (quantum > 0) ? quantum : 1;
-}
+    vector<BasicScheduleResult<int64_t>> results;
+    for (auto& f : pending) results.push_back(f.get());
 
-// Initialize process remaining time and reset fields for scheduling
-void initializeProcesses(vector<Process>& processes) {
-    // Loop through each process
-    for (auto& p : processes) {
-        // Set remaining time equal to burst time
-        p.remaining_time = p.burst_time;
-        // Reset completion time to 0
-        p.completion_time = 0;
-        // Reset turnaround time to 0
-        p.turnaround_time = 0;
-        // Reset waiting time to 0
-        p.waiting_time = 0;
-        // Reset completed flag to false
-        p.completed = false;
+    // Machine-readable formats: only the per-process results, no banner
+    if (options.format != OutputFormat::Table) {
+        return writeResults(view, results, names, options.format, options.output_path, decimals);
     }
+
+    // Print the banner and the recommended quantum time
+    cout << "\n" << string(80, '=') << endl;
+    cout << "CPU SCHEDULING ALGORITHMS" << endl;
+    cout << string(80, '=') << endl;
+    cout << "Total Processes: " << view.size() << endl;
+    cout << string(80, '-') << endl;
+    cout << "Recommended Quantum Time (Median): " << formatTicks(quantum, decimals) << endl;
+    cout << string(80, '=') << "\n" << endl;
+
+    // Display the scheduling results in the order the policies were given
+    for (size_t i = 0; i < results.size(); i++) {
+        displayTable(view, results[i], names[i], decimals);
+        if (options.switch_cost >= 0) displayOverhead(view, results[i], decimals);
+        if (!results[i].levels.empty()) displayLevels(results[i], decimals);
+        if (options.show_gantt) displayGantt(gantts[i], decimals);
+    }
+    cout << "\n" << string(80, '=') << endl;
+    return 0;
 }
 
 // Main function - entry point of the program
-int main() {
+// Usage: scheduling [OPTIONS] [TRACE]    run a CSV or binary trace file
+//                                        (the built-in example if none)
+//        scheduling --convert IN OUT     convert a CSV trace to binary
+//        scheduling --generate N OUT     write a synthetic binary trace of N
+//                                        jobs (see the generator options)
+// Options:
+//   --policies LIST   comma-separated subset of fcfs,sjf,srtf,rr,mlfq,
+//                     priority,ppriority (default: sjf,srtf,rr)
+//   --threads N       worker threads for running policies (default: all cores)
+//   --sweep LO:HI[:STEP]  simulate Round Robin for every quantum in LO..HI
+//                     instead of running the policies
+//   --gantt           print a Gantt chart after each table
+//   --stats           print min/p50/p95/p99/max, mean and standard deviation
+//                     of WT and TAT and Jain's fairness index after each table
+//   --stream          keep no per-process results: feed every completion into
+//                     percentile sketches of WT, TAT and response time and
+//                     print only those (for traces too long to keep results);
+//                     memory then grows with the jobs in flight, so the trace
+//                     must be sorted by arrival time
+//   --sketch-error E  relative error of the --stream percentiles (default 0.01)
+//   --format NAME     table (default), csv, jsonl or binary; the last three
+//                     write only the per-process results, for other programs
+//   --output FILE     write csv, jsonl or binary results to FILE instead of
+//                     standard output (binary needs a file)
+//   --switch-cost N   charge N time units per context switch and report
+//                     switches, overhead and CPU utilization
+//   --cores N         simulate N cores with work stealing (fcfs, sjf, srtf
+//                     and rr only); --threads sets the host threads; not
+//                     with --sweep or --switch-cost
+//   --epoch E         time between work-stealing rounds (default: half the
+//                     median burst)
+//   --levels N        MLFQ queue levels; the top one uses the median quantum
+//                     and each level below doubles it (default: 3)
+//   --boost S         move every MLFQ process back to the top level every S
+//                     time units (default: ten slices of the lowest level)
+//   --aging N         raise a waiting process one priority level every N
+//                     time units in priority/ppriority; 0 disables aging
+//                     (default: the median quantum)
+//   --what-if PID:AT:BT  show how the schedules of sjf, srtf and rr change if
+//                     process PID gets arrival AT and burst BT (or is added,
+//                     if no process has that PID), re-simulating only the
+//                     part of the schedule the change affects
+//   --decimals D      read arrival and burst times with up to D fractional
+//                     digits (e.g. 99.99 with D = 2) from a CSV trace and
+//                     schedule them exactly as 64-bit fixed-point ticks;
+//                     --switch-cost, --boost and --aging stay in whole units
+//                     (not with --cores, --sweep, --what-if, --stream, --stats
+//                     or --format binary)
+// Generator options (with --generate; --threads sets the generator threads):
+//   --arrivals NAME   uniform, poisson or bursty (default: poisson)
+//   --bursts NAME     uniform, exponential, pareto or bimodal
+//                     (default: exponential)
+//   --load L          mean burst over mean arrival gap (default: 0.9)
+//   --priorities K    random priorities in 0..K-1 (default: none)
+//   --seed N          random seed; a seed always gives the same trace
+//                     (default: 1)
+int main(int argc, char* argv[]) {
     // Create a vector of processes with predefined data
     vector<Process> processes = {
        
@@ -393,6 +457,337 @@ int main() {
         {8, 5, 27}
     };
     
+    // Build the column table once; every algorithm reads it without copying
+    ProcessTable table;
+    // Memory-mapped binary trace, if one was given
+    unique_ptr<MappedTrace> mapped;
+    // Columns the algorithms will read
+    ProcessView view;
+    
+    // Policies to run, by short name
+    vector<string> policy_names = {"sjf", "srtf", "rr"};
+    // Worker threads (0 = one per hardware thread)
+    unsigned threads = 0;
+    // Trace file to load, if any
+    string trace_path;
+    // Quantum sweep range (sweep_step 0 = no sweep)
+    int sweep_first = 0, sweep_last = 0, sweep_step = 0;
+    // Record and print Gantt charts
+    bool show_gantt = false;
+    // Print percentile and fairness statistics
+    bool show_stats = false;
+    // Stream completions into sketches instead of keeping result columns
+    bool stream = false;
+    double sketch_error = 0.01;
+    // Result format and file (empty = standard output)
+    string format_name = "table", output_path;
+    // Dispatch latency per context switch (-1 = not modelled, no report)
+    int switch_cost = -1;
+    // Simulated cores (0 = the single-CPU engines) and steal interval
+    int cores = 0, epoch = 0;
+    // MLFQ levels and boost interval (0 = default)
+    int mlfq_levels = 3, boost = 0;
+    // Priority aging interval (-1 = the median quantum, 0 = no aging)
+    int aging = -1;
+    // Fractional digits of the times (0 = whole time units)
+    int decimals = 0;
+    // Fixed-point copy of the input when decimals > 0
+    BasicProcessTable<int64_t> fixed_table;
+    // What-if change (pid, arrival, burst), if one was given
+    bool what_if = false;
+    int what_if_pid = 0, what_if_at = 0, what_if_bt = 0;
+    // Synthetic trace to write, if --generate was given
+    string generate_path, arrival_name = "poisson", burst_name = "exponential";
+    WorkloadSpec spec;
+    
+    try {
+        // Convert a CSV trace to the binary format and exit
+        if (argc == 4 && string(argv[1]) == "--convert") {
+            convertCsvToBinary(argv[2], argv[3]);
+            return 0;
+        }
+        // Read the command line options
+        for (int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            if (arg == "--policies" && i + 1 < argc) {
+                // Split the comma-separated list
+                policy_names.clear();
+                string list = argv[++i];
+                for (size_t start = 0, comma; start <= list.size(); start = comma + 1) {
+                    comma = list.find(',', start);
+                    if (comma == string::npos) comma = list.size();
+                    policy_names.push_back(list.substr(start, comma - start));
+                }
+            } else if (arg == "--threads" && i + 1 < argc) {
+                threads = stoul(argv[++i]);
+            } else if (arg == "--switch-cost" && i + 1 < argc) {
+                switch_cost = stoi(argv[++i]);
+                if (switch_cost < 0) {
+                    cerr << "Error: --switch-cost must not be negative" << endl;
+                    return 1;
+                }
+            } else if (arg == "--cores" && i + 1 < argc) {
+                cores = stoi(argv[++i]);
+                if (cores < 1) {
+                    cerr << "Error: --cores must be at least 1" << endl;
+                    return 1;
+                }
+            } else if (arg == "--epoch" && i + 1 < argc) {
+                epoch = stoi(argv[++i]);
+            } else if (arg == "--levels" && i + 1 < argc) {
+                mlfq_levels = stoi(argv[++i]);
+                if (mlfq_levels < 1 || mlfq_levels > 16) {
+                    cerr << "Error: --levels must be between 1 and 16" << endl;
+                    return 1;
+                }
+            } else if (arg == "--boost" && i + 1 < argc) {
+                boost = stoi(argv[++i]);
+                if (boost < 0) {
+                    cerr << "Error: --boost must not be negative" << endl;
+                    return 1;
+                }
+            } else if (arg == "--aging" && i + 1 < argc) {
+                aging = stoi(argv[++i]);
+                if (aging < 0) {
+                    cerr << "Error: --aging must not be negative" << endl;
+                    return 1;
+                }
+            } else if (arg == "--what-if" && i + 1 < argc) {
+                // Read PID:AT:BT
+                string change = argv[++i];
+                size_t colon = change.find(':');
+                size_t colon2 = colon == string::npos ? colon : change.find(':', colon + 1);
+                if (colon2 == string::npos) throw invalid_argument("what-if");
+                what_if_pid = stoi(change.substr(0, colon));
+                what_if_at = stoi(change.substr(colon + 1, colon2 - colon - 1));
+                what_if_bt = stoi(change.substr(colon2 + 1));
+                if (what_if_at < 0 || what_if_bt < 0) {
+                    cerr << "Error: --what-if needs non-negative AT and BT" << endl;
+                    return 1;
+                }
+                what_if = true;
+            } else if (arg == "--decimals" && i + 1 < argc) {
+                decimals = stoi(argv[++i]);
+                if (decimals < 0 || decimals > 9) {
+                    cerr << "Error: --decimals must be between 0 and 9" << endl;
+                    return 1;
+                }
+            } else if (arg == "--generate" && i + 2 < argc) {
+                spec.jobs = stoull(argv[++i]);
+                generate_path = argv[++i];
+            } else if (arg == "--arrivals" && i + 1 < argc) {
+                arrival_name = argv[++i];
+            } else if (arg == "--bursts" && i + 1 < argc) {
+                burst_name = argv[++i];
+            } else if (arg == "--load" && i + 1 < argc) {
+                spec.load = stod(argv[++i]);
+            } else if (arg == "--priorities" && i + 1 < argc) {
+                spec.priority_levels = stoi(argv[++i]);
+            } else if (arg == "--seed" && i + 1 < argc) {
+                spec.seed = stoull(argv[++i]);
+            } else if (arg == "--gantt") {
+                show_gantt = true;
+            } else if (arg == "--stats") {
+                show_stats = true;
+            } else if (arg == "--format" && i + 1 < argc) {
+                format_name = argv[++i];
+            } else if (arg == "--output" && i + 1 < argc) {
+                output_path = argv[++i];
+            } else if (arg == "--stream") {
+                stream = true;
+            } else if (arg == "--sketch-error" && i + 1 < argc) {
+                sketch_error = stod(argv[++i]);
+                if (!(sketch_error > 0 && sketch_error < 1)) {
+                    cerr << "Error: --sketch-error must be between 0 and 1" << endl;
+                    return 1;
+                }
+            } else if (arg == "--sweep" && i + 1 < argc) {
+                // Read LO:HI and the optional :STEP
+                string range = argv[++i];
+                size_t colon = range.find(':');
+                if (colon == string::npos) throw invalid_argument("sweep");
+                sweep_first = stoi(range.substr(0, colon));
+                size_t colon2 = range.find(':', colon + 1);
+                sweep_last = stoi(range.substr(colon + 1, colon2 - colon - 1));
+                sweep_step = colon2 == string::npos ? 1 : stoi(range.substr(colon2 + 1));
+                if (sweep_first < 1 || sweep_last < sweep_first || sweep_step < 1) {
+                    cerr << "Error: --sweep needs 1 <= LO <= HI and STEP >= 1" << endl;
+                    return 1;
+                }
+            } else if (arg[0] != '-' && trace_path.empty()) {
+                trace_path = arg;
+            } else {
+                cerr << "Usage: " << argv[0] << " [--policies fcfs,sjf,srtf,rr,mlfq,priority,ppriority] [--threads N] [--sweep LO:HI[:STEP]] [--gantt] [--stats] [--stream [--sketch-error E]] [--format table|csv|jsonl|binary [--output FILE]] [--switch-cost N] [--cores N [--epoch E]] [--levels N] [--boost S] [--aging N] [--what-if PID:AT:BT] [--decimals D] [TRACE]" << endl;
+                cerr << "       " << argv[0] << " --convert IN.csv OUT.bin" << endl;
+                cerr << "       " << argv[0] << " --generate N OUT.bin [--arrivals uniform|poisson|bursty] [--bursts uniform|exponential|pareto|bimodal] [--load L] [--priorities K] [--seed N] [--threads N]" << endl;
+                return 1;
+            }
+        }
+        if (!generate_path.empty()) {
+            // Write a synthetic trace and exit
+            try {
+                spec.arrivals = arrivalPatternByName(arrival_name);
+                spec.bursts = burstDistributionByName(burst_name);
+                ThreadPool pool(threads);
+                writeWorkload(generate_path, spec, pool);
+            } catch (const exception& e) {
+                cerr << "Error: " << e.what() << endl;
+                return 1;
+            }
+            cout << "Wrote " << spec.jobs << " jobs to " << generate_path << endl;
+            return 0;
+        }
+        if (!trace_path.empty()) {
+            // Binary traces are mapped in place; CSV traces are parsed into columns
+            if (isBinaryTrace(trace_path)) {
+                // Binary traces only hold whole 32-bit times
+                if (decimals > 0) throw runtime_error("--decimals needs a CSV trace");
+                mapped.reset(new MappedTrace(trace_path));
+                view = mapped->view();
+            } else if (decimals > 0) {
+                fixed_table = loadCsvTrace<int64_t>(trace_path, decimals);
+            } else {
+                table = loadCsvTrace(trace_path);
+                view = table;
+            }
+        } else {
+            // No trace given: use the predefined processes
+            table = ProcessTable::fromProcesses(processes);
+            view = table;
+            // Whole units scaled to ticks for a fixed-point run
+            if (decimals > 0) {
+                int64_t unit = ticksPerUnit(decimals);
+                for (const auto& p : processes) fixed_table.add(p.pid, p.arrival_time * unit, p.burst_time * unit, p.priority);
+            }
+        }
+    } catch (const invalid_argument&) {
+        // stoul could not read a number option
+        cerr << "Error: expected a number" << endl;
+        return 1;
+    } catch (const exception& e) {
+        // Report unreadable or malformed trace files
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    if ((decimals > 0 ? fixed_table.size() : view.size()) == 0) {
+        cerr << "Error: trace has no processes" << endl;
+        return 1;
+    }
+    if (what_if && (cores > 0 || sweep_step > 0)) {
+        cerr << "Error: --what-if cannot be combined with --cores or --sweep" << endl;
+        return 1;
+    }
+    // The multicore simulator charges no switch cost and runs one quantum
+    if (cores > 0 && (sweep_step > 0 || switch_cost >= 0)) {
+        cerr << "Error: --cores cannot be combined with --sweep or --switch-cost" << endl;
+        return 1;
+    }
+    if (stream && (cores > 0 || sweep_step > 0 || what_if || show_gantt || show_stats)) {
+        cerr << "Error: --stream cannot be combined with --cores, --sweep, --what-if, --gantt or --stats" << endl;
+        return 1;
+    }
+    // Result format; the other displays only exist in the table format
+    OutputFormat format;
+    try {
+        format = outputFormatByName(format_name);
+    } catch (const invalid_argument& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    if (format != OutputFormat::Table && (cores > 0 || sweep_step > 0 || what_if || stream || show_gantt || show_stats)) {
+        cerr << "Error: --format " << format_name << " cannot be combined with --cores, --sweep, --what-if, --stream, --gantt or --stats" << endl;
+        return 1;
+    }
+    if (format == OutputFormat::Table && !output_path.empty()) {
+        cerr << "Error: --output needs --format csv, jsonl or binary" << endl;
+        return 1;
+    }
+    if (format == OutputFormat::Binary && output_path.empty()) {
+        cerr << "Error: --format binary needs --output FILE" << endl;
+        return 1;
+    }
+    
+    // Fixed-point mode: fractional times on the 64-bit engines
+    if (decimals > 0) {
+        if (cores > 0 || sweep_step > 0 || what_if || stream || show_stats || format == OutputFormat::Binary) {
+            cerr << "Error: --decimals cannot be combined with --cores, --sweep, --what-if, --stream, --stats or --format binary" << endl;
+            return 1;
+        }
+        FixedPointOptions options;
+        options.decimals = decimals;
+        options.threads = threads;
+        options.switch_cost = switch_cost;
+        options.mlfq_levels = mlfq_levels;
+        options.boost = boost;
+        options.aging = aging;
+        options.show_gantt = show_gantt;
+        options.format = format;
+        options.output_path = output_path;
+        return runFixedPoint(BasicProcessView<int64_t>(fixed_table), policy_names, options);
+    }
+    
+    // Streaming keeps memory to the jobs in flight, but putting an unsorted
+    // trace in arrival order takes memory per process
+    if (stream && !arrivalSorted(view)) {
+        cerr << "Error: --stream needs a trace sorted by arrival time" << endl;
+        return 1;
+    }
+
+    // Calculate optimal quantum time based on median burst time
+    int optimal_quantum = calculateOptimalQuantum(view);
+    
+    // Create the selected policies (SJF, SRTF and Round Robin by default)
+    vector<unique_ptr<SchedulingPolicy>> policies;
+    // Multi-core policies (FCFS, SJF, SRTF and RR)
+    vector<CorePolicy> core_policies;
+    for (const auto& name : policy_names) {
+        // What-if re-simulation only covers sjf, srtf and rr
+        if (what_if && name != "sjf" && name != "srtf" && name != "rr") {
+            cerr << "Error: what-if does not support policy '" << name << "'" << endl;
+            return 1;
+        }
+        if (cores > 0) {
+            try {
+                core_policies.push_back(corePolicyByName(name));
+            } catch (const invalid_argument& e) {
+                cerr << "Error: " << e.what() << endl;
+                return 1;
+            }
+            continue;
+        }
+        if (name == "mlfq") {
+            // MLFQ with the configured levels and boost interval
+            policies.emplace_back(new MlfqPolicy(mlfqQuanta(optimal_quantum, mlfq_levels), boost, max(switch_cost, 0)));
+            continue;
+        }
+        if (name == "priority" || name == "ppriority") {
+            // Priority scheduling with the configured aging interval
+            policies.emplace_back(new PriorityPolicy(name == "ppriority", aging < 0 ? optimal_quantum : aging, max(switch_cost, 0)));
+            continue;
+        }
+        policies.push_back(makePolicy(name, optimal_quantum, max(switch_cost, 0)));
+        // Reject names that are not a known policy
+        if (!policies.back()) {
+            cerr << "Error: unknown policy '" << name << "'" << endl;
+            return 1;
+        }
+    }
+    
+    // Machine-readable formats: only the per-process results, no banner
+    if (format != OutputFormat::Table) {
+        ThreadPool pool(threads);
+        vector<ScheduleResult> results;
+        try {
+            results = runPolicies(pool, view, policies);
+        } catch (const overflow_error& e) {
+            cerr << "Error: " << e.what() << endl;
+            return 1;
+        }
+        vector<string> names;
+        for (const auto& policy : policies) names.push_back(policy->name());
+        return writeResults(view, results, names, format, output_path);
+    }
+    
     // Print a separator line
     cout << "\n" << string(80, '=') << endl;
     // Print the title
@@ -400,40 +795,106 @@ int main() {
     // Print another separator line
     cout << string(80, '=') << endl;
     // Print total number of processes
-    cout << "Total Processes: " << processes.size() << endl;
+    cout << "Total Processes: " << view.size() << endl;
     // Print a divider line
     cout << string(80, '-') << endl;
     
-    // Calculate optimal quantum time based on median burst time
-    int optimal_quantum = calculateOptimalQuantum(processes);
     // Print the recommended quantum time
     cout << "Recommended Quantum Time (Median): " << optimal_quantum << endl;
     // Print separator line
     cout << string(80, '=') << "\n" << endl;
     
-    // Execute SJF algorithm
-    // Create a copy of processes
-    vector<Process> temp = processes;
-    // Initialize process fields for SJF
-    initializeProcesses(temp);
-    // Run SJF scheduling
-    sjf(temp);
+    // Multi-core mode: each policy is simulated across the cores, with the
+    // cores' event streams spread over host threads
+    if (cores > 0) {
+        for (CorePolicy policy : core_policies) {
+            MulticoreOptions options;
+            options.cores = cores;
+            options.policy = policy;
+            options.quantum = optimal_quantum;
+            options.epoch = epoch;
+            options.threads = threads;
+            MulticoreResult result = simulateMulticore(view, options);
+            displayTable(view, result.schedule, corePolicyName(policy, optimal_quantum) + " - " + to_string(cores) + " Cores");
+            if (show_stats) displayStats(view, result.schedule);
+            displayCores(result);
+        }
+        cout << "\n" << string(80, '=') << endl;
+        return 0;
+    }
+    
+    // What-if mode: re-simulate only what the changed job affects
+    if (what_if) {
+        // The row of the process to change, or -1 to add a new one
+        int32_t row = -1;
+        for (size_t i = 0; i < view.size() && row < 0; i++) {
+            if (view.pid[i] == what_if_pid) row = i;
+        }
+        for (size_t i = 0; i < policy_names.size(); i++) {
+            WhatIfSimulator simulator(view, replayPolicyByName(policy_names[i]), optimal_quantum, max(switch_cost, 0));
+            WhatIfDiff diff = row >= 0 ? simulator.modify(row, what_if_at, what_if_bt)
+                                       : simulator.insert(what_if_pid, what_if_at, what_if_bt);
+            displayWhatIf(diff, policies[i]->name());
+        }
+        cout << "\n" << string(80, '=') << endl;
+        return 0;
+    }
+    
+    ThreadPool pool(threads);
+    
+    // Sweep mode: simulate every quantum in the range in parallel instead
+    if (sweep_step > 0) {
+        int cost = max(switch_cost, 0);
+        displaySweep(view, sweepQuantum(pool, view, sweep_first, sweep_last, sweep_step, cost), cost);
+        cout << "\n" << string(80, '=') << endl;
+        return 0;
+    }
+    
+    // Streaming mode: every policy feeds its own sketches, and no per-process
+    // results are kept
+    if (stream) {
+        vector<unique_ptr<StreamingStats>> stats;
+        vector<CompletionSink*> sinks;
+        for (size_t i = 0; i < policies.size(); i++) {
+            stats.emplace_back(new StreamingStats(sketch_error));
+            sinks.push_back(stats.back().get());
+        }
+        vector<ScheduleResult> results;
+        try {
+            results = runPolicies(pool, view, policies, nullptr, &sinks);
+        } catch (const overflow_error& e) {
+            cerr << "Error: " << e.what() << endl;
+            return 1;
+        }
+        for (size_t i = 0; i < policies.size(); i++) {
+            displayStreaming(*stats[i], results[i], policies[i]->name(), switch_cost >= 0);
+            if (!results[i].levels.empty()) displayLevels(results[i]);
+        }
+        cout << "\n" << string(80, '=') << endl;
+        return 0;
+    }
     
-    // Execute SRTF algorithm
-    // Create a copy of processes
-    temp = processes;
-    // Initialize process fields for SRTF
-    initializeProcesses(temp);
-    // Run SRTF scheduling
-    srtf(temp);
+    // Run all policies concurrently; each only reads the shared columns and
+    // allocates its own CT/TAT/WT columns
+    // Gantt charts are only recorded when requested
+    vector<GanttChart> gantts;
+    vector<ScheduleResult> results;
+    try {
+        results = runPolicies(pool, view, policies, show_gantt ? &gantts : nullptr);
+    } catch (const overflow_error& e) {
+        // FCFS reports completion times past 32 bits
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
     
-    // Execute Round Robin algorithm
-    // Create a copy of processes
-    temp = processes;
-    // Initialize process fields for RR
-    initializeProcesses(temp);
-    // Run Round Robin scheduling with calculated quantum
-    roundRobin(temp, optimal_quantum);
+    // Display the scheduling results in the order the policies were given
+    for (size_t i = 0; i < policies.size(); i++) {
+        displayTable(view, results[i], policies[i]->name());
+        if (switch_cost >= 0) displayOverhead(view, results[i]);
+        if (show_stats) displayStats(view, results[i]);
+        if (!results[i].levels.empty()) displayLevels(results[i]);
+        if (show_gantt) displayGantt(gantts[i]);
+    }
     
     // Print final separator line
     cout << "\n" << string(80, '=') << endl;
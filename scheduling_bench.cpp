@@ -0,0 +1,432 @@
+// Benchmark suite for the scheduling engines
+// Build: g++ -O2 -pthread scheduling_bench.cpp -o scheduling_bench
+//
+// Times fcfs(), parallelFcfs(), sjf(), srtf() and roundRobin() (plus the arrivalOrder(),
+// radix sort, pidOrder() and median quantum helpers as micro benchmarks) on synthetic traces of 1e3 to
+// 1e7 jobs from scheduling_workload.h, in the style of Google Benchmark: every case is repeated until it
+// has run for --min-time seconds, and the report shows time per run, ns per
+// job, jobs per second, heap allocations per run and the peak resident set
+// size of the case.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <regex>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include "scheduling_core.h"
+#include "scheduling_multicore.h"
+#include "scheduling_parallel.h"
+#include "scheduling_whatif.h"
+#include "scheduling_workload.h"
+// Use standard namespace
+using namespace std;
+
+// Synthetic workload shapes, all with mean burst 10 at 90% CPU load
+//   uniform       uniform gaps and bursts
+//   exponential   Poisson arrivals, exponential bursts
+//   heavy_tailed  Poisson arrivals, Pareto bursts (alpha 1.5)
+//   bursty        groups of ~50 jobs arriving together, exponential bursts
+//   bimodal       Poisson arrivals, 90% short and 10% long jobs
+//   reversed      exponential with the rows in reverse, so the engines have to
+//                 sort the arrivals
+struct Workload {
+    string name;
+    ArrivalPattern arrivals;
+    BurstDistribution bursts;
+    bool reversed = false;
+};
+
+// Heap allocation counting
+// Every operator new in the program goes through these, so a case can report
+// how many allocations one run makes
+atomic<long> allocations(0);
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, align_val_t alignment) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    size_t align = size_t(alignment);
+    if (void* p = aligned_alloc(align, (size + align - 1) / align * align)) return p;
+    throw bad_alloc();
+}
+void* operator new[](size_t size, align_val_t alignment) { return operator new(size, alignment); }
+// Out of line, so the compiler does not pair the free() inside it with the
+// operator new that returned the pointer
+__attribute__((noinline)) void releaseMemory(void* p) { free(p); }
+void operator delete(void* p) noexcept { releaseMemory(p); }
+void operator delete[](void* p) noexcept { releaseMemory(p); }
+void operator delete(void* p, size_t) noexcept { releaseMemory(p); }
+void operator delete[](void* p, size_t) noexcept { releaseMemory(p); }
+void operator delete(void* p, align_val_t) noexcept { releaseMemory(p); }
+void operator delete[](void* p, align_val_t) noexcept { releaseMemory(p); }
+void operator delete(void* p, size_t, align_val_t) noexcept { releaseMemory(p); }
+void operator delete[](void* p, size_t, align_val_t) noexcept { releaseMemory(p); }
+
+// Peak resident set size tracking
+// Linux resets the VmHWM high-water mark when "5" is written to clear_refs,
+// which gives a per-case peak; elsewhere the process-wide peak is reported
+void resetPeakRss() {
+    ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs) clear_refs << "5";
+}
+
+long peakRssKb() {
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return stol(line.substr(6));
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+double cpuSeconds() {
+    return double(clock()) / CLOCKS_PER_SEC;
+}
+
+// Results are folded into this so the optimizer cannot drop a run
+volatile double sink;
+
+// Streaming runs fold their completions into sink instead of result columns
+struct FoldSink : CompletionSink {
+    void started(const ProcessView&, int32_t, int64_t) override {}
+    void completed(const ProcessView&, int32_t, int32_t ct) override { sink = sink + ct; }
+};
+
+// One engine (or helper) under test
+struct Engine {
+    string name;
+    function<void(const ProcessTable&, int)> run;   // (table, RR quantum)
+    int result_allocations = 0;     // Heap blocks the returned result owns, allowed by --check-allocations
+};
+
+// Measurements of one benchmark case
+struct Measurement {
+    string name;
+    size_t jobs;
+    long iterations;
+    double wall_ms;             // Mean wall time per run
+    double cpu_ms;              // Mean CPU time per run
+    double allocations;         // Mean heap allocations per run after the first
+    long peak_rss_kb;
+};
+
+// Run one case until it has taken at least min_time seconds (and at least once)
+// The first run warms up the engines' arenas, so allocations are counted over
+// the runs after it (over the first run if there is only one)
+Measurement measure(const string& name, const Engine& engine, const ProcessTable& table, int quantum, double min_time) {
+    resetPeakRss();
+    long iterations = 0;
+    double wall = 0, cpu = 0;
+    long first_allocations = 0, allocations_before = allocations;
+    while (iterations == 0 || wall < min_time) {
+        auto start = chrono::steady_clock::now();
+        double cpu_start = cpuSeconds();
+        engine.run(table, quantum);
+        cpu += cpuSeconds() - cpu_start;
+        wall += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (iterations == 0) first_allocations = allocations - allocations_before;
+        iterations++;
+    }
+    long counted = allocations - allocations_before;
+    double per_run = iterations > 1 ? double(counted - first_allocations) / (iterations - 1) : counted;
+    return {name, table.size(), iterations, 1e3 * wall / iterations, 1e3 * cpu / iterations, per_run, peakRssKb()};
+}
+
+// Print one result line in the selected format
+void report(const Measurement& m, bool csv) {
+    double ns_per_job = 1e6 * m.wall_ms / m.jobs;
+    double jobs_per_second = m.jobs / (m.wall_ms / 1e3);
+    if (csv) {
+        cout << m.name << "," << m.jobs << "," << m.iterations << "," << fixed << setprecision(4) << m.wall_ms << ","
+             << m.cpu_ms << "," << setprecision(2) << ns_per_job << "," << setprecision(0) << jobs_per_second << ","
+             << setprecision(2) << m.allocations << "," << m.peak_rss_kb << endl;
+        return;
+    }
+    cout << left << setw(40) << m.name
+         << right << setw(12) << fixed << setprecision(3) << m.wall_ms
+         << setw(12) << m.cpu_ms
+         << setw(8) << m.iterations
+         << setw(10) << setprecision(1) << ns_per_job
+         << setw(12) << setprecision(2) << jobs_per_second / 1e6
+         << setw(10) << setprecision(1) << m.allocations
+         << setw(10) << m.peak_rss_kb / 1024 << endl;
+}
+
+// Correctness checks run by --check: small traces whose schedules are known,
+// kept here as regressions for behaviour that is easy to break again
+struct Check {
+    string name;
+    function<bool()> run;       // True if the engine still behaves
+};
+
+// Same Gantt segments (pid, start, end) in the same order
+bool sameChart(const GanttChart& chart, const vector<GanttSegment>& expected) {
+    if (chart.segments.size() != expected.size()) return false;
+    for (size_t i = 0; i < expected.size(); i++) {
+        const GanttSegment& a = chart.segments[i];
+        const GanttSegment& b = expected[i];
+        if (a.pid != b.pid || a.start != b.start || a.end != b.end) return false;
+    }
+    return true;
+}
+
+// Same CT/TAT/WT per row and the same switch counts
+bool sameResult(const ScheduleResult& a, const ScheduleResult& b) {
+    return a.completion_time == b.completion_time && a.turnaround_time == b.turnaround_time &&
+           a.waiting_time == b.waiting_time && a.context_switches == b.context_switches &&
+           a.switch_overhead == b.switch_overhead;
+}
+
+vector<Check> checks() {
+    return {
+        // A waiting job that ages to the running job's priority must not
+        // preempt it, even though it arrived earlier: only P1 aging to 0
+        // (strictly better than P2's 1) takes the CPU back
+        {"priority_aging_equal_priority_no_preempt", [] {
+            ProcessTable table;
+            table.add(1, 0, 20, 2);
+            table.add(2, 5, 20, 1);
+            GanttChart chart;
+            ScheduleResult result = priorityScheduling(table, true, 3, &chart);
+            return sameChart(chart, {{1, 0, 5}, {2, 5, 11}, {1, 11, 26}, {2, 26, 40}}) &&
+                   result.context_switches == 3;
+        }},
+        // The what-if ReplayEngine keeps its own copy of the sjf(), srtf() and
+        // roundRobin() loops; its full baseline run must match them row for
+        // row, on sorted and unsorted traces with arrival ties and switch costs
+        {"replay_matches_engines", [] {
+            ThreadPool pool(1);
+            bool ok = true;
+            for (ArrivalPattern arrivals : {ArrivalPattern::Poisson, ArrivalPattern::Bursty}) {
+                WorkloadSpec spec;
+                spec.jobs = 5000;
+                spec.arrivals = arrivals;
+                ProcessTable sorted = generateWorkload(spec, pool);
+                ProcessTable reversed;
+                for (size_t i = sorted.size(); i-- > 0;) {
+                    reversed.add(sorted.pid[i], sorted.arrival_time[i], sorted.burst_time[i]);
+                }
+                for (const ProcessTable* table : {&sorted, &reversed}) {
+                    for (int switch_cost : {0, 2}) {
+                        int quantum = calculateOptimalQuantum(*table);
+                        ok = ok &&
+                             sameResult(WhatIfSimulator(*table, ReplayPolicy::SJF, quantum, switch_cost).result(),
+                                        sjf(*table, nullptr, switch_cost)) &&
+                             sameResult(WhatIfSimulator(*table, ReplayPolicy::SRTF, quantum, switch_cost).result(),
+                                        srtf(*table, nullptr, switch_cost)) &&
+                             sameResult(WhatIfSimulator(*table, ReplayPolicy::RR, quantum, switch_cost).result(),
+                                        roundRobin(*table, quantum, nullptr, switch_cost));
+                    }
+                }
+            }
+            return ok;
+        }},
+        // One simulated core has nobody to steal from, so it must schedule
+        // exactly like the single-core engines, also when the rows are not in
+        // arrival order and the epochs cut through RR slices
+        {"multicore_one_core_matches_engines", [] {
+            ThreadPool pool(1);
+            bool ok = true;
+            for (ArrivalPattern arrivals : {ArrivalPattern::Poisson, ArrivalPattern::Bursty}) {
+                WorkloadSpec spec;
+                spec.jobs = 5000;
+                spec.arrivals = arrivals;
+                ProcessTable sorted = generateWorkload(spec, pool);
+                ProcessTable table;
+                for (size_t i = sorted.size(); i-- > 0;) {
+                    table.add(sorted.pid[i], sorted.arrival_time[i], sorted.burst_time[i]);
+                }
+                int quantum = calculateOptimalQuantum(table);
+                for (CorePolicy policy : {CorePolicy::FCFS, CorePolicy::SJF, CorePolicy::SRTF, CorePolicy::RR}) {
+                    MulticoreOptions options;
+                    options.cores = 1;
+                    options.policy = policy;
+                    options.quantum = quantum;
+                    options.threads = 1;
+                    ScheduleResult expected = policy == CorePolicy::FCFS ? fcfs(table)
+                                              : policy == CorePolicy::SJF ? sjf(table)
+                                              : policy == CorePolicy::SRTF ? srtf(table)
+                                              : roundRobin(table, quantum);
+                    ok = ok && sameResult(simulateMulticore(table, options).schedule, expected);
+                }
+            }
+            return ok;
+        }},
+    };
+}
+
+// Main function - entry point of the benchmark
+// Usage: scheduling_bench [--filter REGEX] [--min-time S] [--max-jobs N]
+//                         [--seed N] [--csv] [--check-allocations]
+//        scheduling_bench --check
+//   --filter REGEX    only run cases whose name matches, e.g. "srtf/.*/1000000"
+//   --min-time S      minimum seconds per case (default 0.2)
+//   --max-jobs N      largest trace size, a power of ten from 1e3 (default
+//                     1e6; 1e7 needs several hundred MB)
+//   --seed N          workload seed (default 1)
+//   --csv             print name,jobs,iterations,wall_ms,cpu_ms,ns_per_job,
+//                     jobs_per_s,allocs_per_run,peak_rss_kb lines for
+//                     regression tracking
+//   --check-allocations
+//                     fail (exit status 2) if a streaming case ("_stream"),
+//                     whose engine state lives in the per-thread arena,
+//                     allocates after its first run beyond the blocks its
+//                     result owns
+//   --check           only run the correctness checks; exit status 2 if any
+//                     fails
+int main(int argc, char* argv[]) {
+    // Command line options
+    string filter = ".*";
+    double min_time = 0.2;
+    size_t max_jobs = 1000000;
+    uint64_t seed = 1;
+    bool csv = false;
+    bool check_allocations = false;
+    bool check_only = false;
+    try {
+        for (int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            if (arg == "--filter" && i + 1 < argc) filter = argv[++i];
+            else if (arg == "--min-time" && i + 1 < argc) min_time = stod(argv[++i]);
+            else if (arg == "--max-jobs" && i + 1 < argc) max_jobs = stoull(argv[++i]);
+            else if (arg == "--seed" && i + 1 < argc) seed = stoull(argv[++i]);
+            else if (arg == "--csv") csv = true;
+            else if (arg == "--check-allocations") check_allocations = true;
+            else if (arg == "--check") check_only = true;
+            else {
+                cerr << "Usage: " << argv[0] << " [--filter REGEX] [--min-time S] [--max-jobs N] [--seed N] [--csv]"
+                     << " [--check-allocations]" << endl;
+                cerr << "       " << argv[0] << " --check" << endl;
+                return 1;
+            }
+        }
+    } catch (const exception&) {
+        cerr << "Error: expected a number" << endl;
+        return 1;
+    }
+    if (check_only) {
+        bool failed = false;
+        for (const Check& c : checks()) {
+            bool ok = c.run();
+            cout << "check " << c.name << ": " << (ok ? "ok" : "FAILED") << endl;
+            failed = failed || !ok;
+        }
+        return failed ? 2 : 0;
+    }
+    regex pattern;
+    try {
+        pattern = regex(filter);
+    } catch (const regex_error&) {
+        cerr << "Error: invalid --filter expression" << endl;
+        return 1;
+    }
+
+    // Workloads are generated on every hardware thread
+    ThreadPool pool;
+
+    // Engines under test; each folds its result into sink
+    vector<Engine> engines = {
+        {"fcfs", [](const ProcessTable& t, int) { sink = sink + fcfs(t).averageWaiting(); }},
+        {"fcfs_parallel", [&pool](const ProcessTable& t, int) { sink = sink + parallelFcfs(pool, t).averageWaiting(); }},
+        {"sjf", [](const ProcessTable& t, int) { sink = sink + sjf(t).averageWaiting(); }},
+        {"srtf", [](const ProcessTable& t, int) { sink = sink + srtf(t).averageWaiting(); }},
+        {"rr", [](const ProcessTable& t, int q) { sink = sink + roundRobin(t, q).averageWaiting(); }},
+        {"arrival_order", [](const ProcessTable& t, int) { sink = sink + arrivalOrder(t)[0]; }},
+        // Generated traces arrive in order, so the radix sort is timed on the bursts
+        {"burst_order", [](const ProcessTable& t, int) { sink = sink + sortedRows(t.burst_time.data(), t.size())[0]; }},
+        {"burst_order_parallel", [&pool](const ProcessTable& t, int) {
+            uint32_t max_key;
+            vector<uint64_t> entries = radixEntries(t.burst_time.data(), t.size(), max_key);
+            parallelRadixSort(pool, entries, max_key);
+            sink = sink + int32_t(entries[0]);
+        }},
+        {"pid_order", [](const ProcessTable& t, int) { sink = sink + pidOrder(t)[0]; }},
+        // Streaming runs have no result columns, so after the first run they
+        // should not touch the heap at all
+        {"fcfs_stream", [](const ProcessTable& t, int) { FoldSink s; fcfs(t, nullptr, 0, &s); }},
+        {"sjf_stream", [](const ProcessTable& t, int) { FoldSink s; sjf(t, nullptr, 0, &s); }},
+        {"srtf_stream", [](const ProcessTable& t, int) { FoldSink s; srtf(t, nullptr, 0, &s); }},
+        {"rr_stream", [](const ProcessTable& t, int q) { FoldSink s; roundRobin(t, q, nullptr, 0, &s); }},
+        {"priority_stream", [](const ProcessTable& t, int) { FoldSink s; priorityScheduling(t, true, 5, nullptr, 0, &s); }},
+        // MLFQ streams too, but keeps its per-level counters in the result
+        {"mlfq_stream", [](const ProcessTable& t, int q) {
+            FoldSink s;
+            int32_t quanta[] = {q, 2 * q, 4 * q};
+            runFeedbackQueue<int32_t>(t, quanta, 3, 0, nullptr, 0, &s, true);
+        }, 1},
+        {"median_quantum", [](const ProcessTable& t, int) { sink = sink + calculateOptimalQuantum(t); }},
+    };
+    vector<Workload> workloads = {
+        {"uniform", ArrivalPattern::Uniform, BurstDistribution::Uniform},
+        {"exponential", ArrivalPattern::Poisson, BurstDistribution::Exponential},
+        {"heavy_tailed", ArrivalPattern::Poisson, BurstDistribution::Pareto},
+        {"bursty", ArrivalPattern::Bursty, BurstDistribution::Exponential},
+        {"bimodal", ArrivalPattern::Poisson, BurstDistribution::Bimodal},
+        {"reversed", ArrivalPattern::Poisson, BurstDistribution::Exponential, true},
+    };
+    // Print the header
+    if (csv) {
+        cout << "name,jobs,iterations,wall_ms,cpu_ms,ns_per_job,jobs_per_s,allocs_per_run,peak_rss_kb" << endl;
+    } else {
+        cout << left << setw(40) << "Benchmark"
+             << right << setw(12) << "Time(ms)"
+             << setw(12) << "CPU(ms)"
+             << setw(8) << "Iter"
+             << setw(10) << "ns/job"
+             << setw(12) << "Mjobs/s"
+             << setw(10) << "Allocs"
+             << setw(10) << "RSS(MB)" << endl;
+        cout << string(114, '-') << endl;
+    }
+
+    // Every workload at every size, generated once and shared by the engines
+    bool failed = false;
+    for (size_t jobs = 1000; jobs <= max_jobs; jobs *= 10) {
+        for (const Workload& w : workloads) {
+            vector<pair<string, const Engine*>> cases;
+            for (const auto& engine : engines) {
+                string name = engine.name + "/" + w.name + "/" + to_string(jobs);
+                if (regex_search(name, pattern)) cases.push_back({name, &engine});
+            }
+            if (cases.empty()) continue;
+            WorkloadSpec spec;
+            spec.jobs = jobs;
+            spec.arrivals = w.arrivals;
+            spec.bursts = w.bursts;
+            spec.seed = seed;
+            ProcessTable table = generateWorkload(spec, pool);
+            if (w.reversed) {
+                reverse(table.pid.begin(), table.pid.end());
+                reverse(table.arrival_time.begin(), table.arrival_time.end());
+                reverse(table.burst_time.begin(), table.burst_time.end());
+                reverse(table.priority.begin(), table.priority.end());
+            }
+            int quantum = calculateOptimalQuantum(table);
+            for (const auto& c : cases) {
+                Measurement m = measure(c.first, *c.second, table, quantum, min_time);
+                report(m, csv);
+                if (check_allocations && c.second->name.find("_stream") != string::npos &&
+                    m.allocations > c.second->result_allocations) {
+                    cerr << "Error: " << m.name << " allocates " << m.allocations << " times per run" << endl;
+                    failed = true;
+                }
+            }
+        }
+    }
+    return failed ? 2 : 0;
+}
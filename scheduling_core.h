@@ -0,0 +1,1437 @@
+// Shared CPU scheduling core used by scheduling.cpp, exam.cpp,
+// scheduling_short.cpp and scheduling_compact.cpp.
+//
+// Header-only so every front-end still builds as a single file:
+//     g++ scheduling.cpp -o scheduling
+//
+// The engines never print anything. They read a shared ProcessView and
+// return a ScheduleResult with CT/TAT/WT columns; toProcesses() joins the two
+// back into rows so each front-end can keep its own output format.
+//
+// Every table, result and engine is a template on the time type. The default
+// int32_t counts whole time units; BasicProcessTable<int64_t> holds scaled
+// fixed-point ticks (10^decimals per unit, see ticksPerUnit()), so traces
+// with fractional bursts like 99.99 run through the same integer engines
+// with exact results. Only the time columns change type; pid and priority
+// stay int32_t.
+//
+// An engine's working state (ready queues, heaps, arrival order) comes from
+// a per-thread ScratchArena that is rewound after every run, so repeated runs
+// such as a quantum sweep stop allocating once the arena has grown to fit.
+#ifndef SCHEDULING_CORE_H
+#define SCHEDULING_CORE_H
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SCHEDULING_HAVE_AVX2_DISPATCH 1
+#endif
+
+// Process structure to hold process information
+// Row-oriented view used by the front-ends for input literals and display;
+// the engines themselves work on the column-oriented ProcessTable below
+struct Process {
+    int pid;                    // Process ID - unique identifier for each process
+    int arrival_time;           // AT - time when process arrives in queue
+    int burst_time;             // BT - total CPU time needed for process
+    int remaining_time;         // Remaining time - CPU time still needed
+    int completion_time;        // CT - time when process finishes execution
+    int turnaround_time;        // TAT - completion time minus arrival time
+    int waiting_time;           // WT - turnaround time minus burst time
+    bool completed;             // Flag to mark if process is completed
+    int priority = 0;           // Priority - lower value runs first
+};
+
+// Structure-of-arrays process table holding only the scheduler inputs
+// One contiguous column per field, so the hot loops stream through
+// arrival/burst without dragging the other fields into cache. A table is
+// built once and shared read-only by every algorithm run.
+template <typename Time>
+struct BasicProcessTable {
+    std::vector<int32_t> pid;           // Process ID
+    std::vector<Time> arrival_time;     // AT
+    std::vector<Time> burst_time;       // BT
+    std::vector<int32_t> priority;      // Priority (lower runs first)
+
+    size_t size() const { return pid.size(); }
+
+    void reserve(size_t n) {
+        pid.reserve(n);
+        arrival_time.reserve(n);
+        burst_time.reserve(n);
+        priority.reserve(n);
+    }
+
+    void clear() {
+        pid.clear();
+        arrival_time.clear();
+        burst_time.clear();
+        priority.clear();
+    }
+
+    // Append one process as a new row
+    void add(int32_t p, Time at, Time bt, int32_t prio = 0) {
+        pid.push_back(p);
+        arrival_time.push_back(at);
+        burst_time.push_back(bt);
+        priority.push_back(prio);
+    }
+
+    // Build a table from front-end Process literals (row order is kept)
+    static BasicProcessTable fromProcesses(const std::vector<Process>& processes) {
+        BasicProcessTable table;
+        table.reserve(processes.size());
+        for (const auto& p : processes) table.add(p.pid, p.arrival_time, p.burst_time, p.priority);
+        return table;
+    }
+};
+
+typedef BasicProcessTable<int32_t> ProcessTable;
+
+// Read-only view of the input columns, which is what the engines consume
+// It can point into a ProcessTable or straight into a memory-mapped trace
+// file (see scheduling_trace.h), so large traces are never copied.
+template <typename Time>
+struct BasicProcessView {
+    const int32_t* pid = nullptr;
+    const Time* arrival_time = nullptr;
+    const Time* burst_time = nullptr;
+    const int32_t* priority = nullptr;  // Null when the source has no priorities
+    size_t rows = 0;
+
+    BasicProcessView() {}
+    BasicProcessView(const BasicProcessTable<Time>& table)
+        : pid(table.pid.data()), arrival_time(table.arrival_time.data()),
+          burst_time(table.burst_time.data()), priority(table.priority.data()), rows(table.size()) {}
+
+    size_t size() const { return rows; }
+    // Priority of a row, 0 for every row if the source has none
+    int32_t priorityOf(size_t row) const { return priority ? priority[row] : 0; }
+};
+
+typedef BasicProcessView<int32_t> ProcessView;
+
+// Counters for one queue level of a multilevel feedback queue run
+struct LevelStats {
+    int64_t quantum = 0;        // Time slice at this level
+    int64_t dispatches = 0;     // Slices started at this level
+    int64_t run_time = 0;       // CPU time spent on this level's slices
+    int64_t completions = 0;    // Processes that finished at this level
+    int64_t demotions = 0;      // Processes moved down after using a full slice
+    int64_t preemptions = 0;    // Slices cut short by an arrival at the top level
+    int64_t boosts = 0;         // Processes moved back to the top by a boost
+};
+
+// Receiver of a run's events in streaming mode, where the per-row output
+// columns are never allocated (see scheduling_sketch.h)
+template <typename Time>
+class BasicCompletionSink {
+public:
+    virtual ~BasicCompletionSink() {}
+    // A row was dispatched for the first time, t being when it started running
+    virtual void started(const BasicProcessView<Time>& table, int32_t row, int64_t t) = 0;
+    // A row finished at ct
+    virtual void completed(const BasicProcessView<Time>& table, int32_t row, Time ct) = 0;
+};
+
+typedef BasicCompletionSink<int32_t> CompletionSink;
+
+// Output columns of one algorithm run, indexed by ProcessTable row
+// Only these are allocated per run; the inputs stay in the shared table.
+// With a sink the columns stay empty and completions go to the sink instead.
+template <typename Time>
+struct BasicScheduleResult {
+    std::vector<Time> completion_time;      // CT
+    std::vector<Time> turnaround_time;      // TAT
+    std::vector<Time> waiting_time;         // WT
+    int64_t context_switches = 0;           // Dispatches of a different process than the last one
+    int64_t switch_overhead = 0;            // Time spent on dispatch latency
+    std::vector<LevelStats> levels;         // Per-level counters of feedback queue runs
+    BasicCompletionSink<Time>* sink = nullptr;
+
+    explicit BasicScheduleResult(size_t n = 0, BasicCompletionSink<Time>* sink = nullptr)
+        : completion_time(sink ? 0 : n), turnaround_time(sink ? 0 : n), waiting_time(sink ? 0 : n), sink(sink) {}
+
+    size_t size() const { return completion_time.size(); }
+
+    double averageWaiting() const { return average(waiting_time); }
+    double averageTurnaround() const { return average(turnaround_time); }
+
+    // Record completion time of a row and derive TAT and WT from it
+    void complete(const BasicProcessView<Time>& table, int32_t row, Time ct) {
+        if (sink) {
+            sink->completed(table, row, ct);
+            return;
+        }
+        completion_time[row] = ct;
+        turnaround_time[row] = ct - table.arrival_time[row];
+        waiting_time[row] = turnaround_time[row] - table.burst_time[row];
+    }
+
+    // Note the first time a row gets the CPU (only streaming runs use it)
+    void start(const BasicProcessView<Time>& table, int32_t row, int64_t t) {
+        if (sink) sink->started(table, row, t);
+    }
+
+    // Count a switch when the CPU starts a different process than the one
+    // that ran last (even after an idle gap) and charge switch_cost for it;
+    // returns the latency the engine must add to the timeline
+    Time dispatch(int32_t row, int32_t& last_row, Time switch_cost = 0) {
+        bool switched = last_row >= 0 && last_row != row;
+        last_row = row;
+        if (!switched) return 0;
+        context_switches++;
+        switch_overhead += switch_cost;
+        return switch_cost;
+    }
+
+    // Share of [first arrival, last completion] spent running processes;
+    // the rest went to idle gaps and switch overhead
+    double cpuUtilization(const BasicProcessView<Time>& table) const {
+        if (table.size() == 0) return 0;
+        int64_t busy = 0;
+        Time first = table.arrival_time[0], last = completion_time[0];
+        for (size_t i = 0; i < table.size(); i++) {
+            busy += table.burst_time[i];
+            first = std::min(first, table.arrival_time[i]);
+            last = std::max(last, completion_time[i]);
+        }
+        return last > first ? double(busy) / (last - first) : 1.0;
+    }
+
+private:
+    static double average(const std::vector<Time>& column) {
+        double total = 0;
+        for (Time v : column) total += v;
+        return column.empty() ? 0 : total / column.size();
+    }
+};
+
+typedef BasicScheduleResult<int32_t> ScheduleResult;
+
+// One stretch of time during which a single process held the CPU
+template <typename Time>
+struct BasicGanttSegment {
+    int32_t pid;
+    Time start;
+    Time end;
+};
+
+typedef BasicGanttSegment<int32_t> GanttSegment;
+
+// Segment pid used for time spent switching between processes
+const int32_t GANTT_SWITCH = -1;
+
+// Growable, run-length coalesced Gantt timeline
+// A slice that continues the previous segment's process without a gap is
+// merged into it, so memory grows with context switches, not simulated time.
+// Engines take a GanttChart pointer and skip recording when it is null.
+template <typename Time>
+struct BasicGanttChart {
+    std::vector<BasicGanttSegment<Time>> segments;
+
+    void record(int32_t pid, Time start, Time end) {
+        if (start == end) return;
+        if (!segments.empty() && segments.back().pid == pid && segments.back().end == start) {
+            segments.back().end = end;
+        } else {
+            segments.push_back({pid, start, end});
+        }
+    }
+};
+
+typedef BasicGanttChart<int32_t> GanttChart;
+
+// Engine parameters name their time type through these aliases, which the
+// compiler does not deduce from: a call either names it (sjf<int64_t>(...))
+// or gets int32_t, so passing a ProcessTable, a null chart or a plain int
+// cost works as before
+template <typename T>
+struct TimeParameter {
+    typedef T type;
+};
+template <typename Time> using TimeOf = typename TimeParameter<Time>::type;
+template <typename Time> using ViewOf = typename TimeParameter<BasicProcessView<Time>>::type;
+template <typename Time> using GanttOf = typename TimeParameter<BasicGanttChart<Time>>::type;
+template <typename Time> using SinkOf = typename TimeParameter<BasicCompletionSink<Time>>::type;
+
+// Ticks per whole time unit at the given number of decimals (10^decimals)
+inline int64_t ticksPerUnit(int decimals) {
+    int64_t ticks = 1;
+    for (int i = 0; i < decimals; i++) ticks *= 10;
+    return ticks;
+}
+
+// Fixed-point ticks as a decimal number, e.g. 9999 at 2 decimals is "99.99"
+inline std::string formatTicks(int64_t ticks, int decimals) {
+    if (decimals == 0) return std::to_string(ticks);
+    int64_t unit = ticksPerUnit(decimals);
+    std::string fraction = std::to_string((ticks < 0 ? -(ticks % unit) : ticks % unit) + unit).substr(1);
+    std::string whole = std::to_string(ticks / unit);
+    if (ticks < 0 && ticks / unit == 0) whole = "-0";
+    return whole + "." + fraction;
+}
+
+// LSD radix sort of packed (key, row) entries
+// Each entry holds an unsigned 32-bit key in its high half and a row index in
+// its low half. Passes go over RADIX_BITS of the key at a time, least
+// significant first, and only as many as the largest key needs; every pass
+// is a stable counting scatter, so equal keys keep their row order and the
+// result is the same as a stable comparison sort, in O(n) per pass.
+static const int RADIX_BITS = 11;
+static const size_t RADIX_BUCKETS = size_t(1) << RADIX_BITS;
+
+// Digit passes needed for keys up to max_key
+inline int radixPasses(uint32_t max_key) {
+    int passes = 0;
+    while (passes * RADIX_BITS < 32 && (uint64_t(max_key) >> (passes * RADIX_BITS)) != 0) passes++;
+    return passes;
+}
+
+// Shift of the digit sorted by the given pass
+inline int radixShift(int pass) { return 32 + pass * RADIX_BITS; }
+
+inline size_t radixDigit(uint64_t entry, int shift) { return (entry >> shift) & (RADIX_BUCKETS - 1); }
+
+// One stable pass: scatter from into to by the digit at shift
+inline void radixPass(const uint64_t* from, uint64_t* to, size_t n, int shift) {
+    size_t start[RADIX_BUCKETS] = {};
+    for (size_t i = 0; i < n; i++) start[radixDigit(from[i], shift)]++;
+    size_t position = 0;
+    for (size_t& s : start) {
+        size_t count = s;
+        s = position;
+        position += count;
+    }
+    for (size_t i = 0; i < n; i++) to[start[radixDigit(from[i], shift)]++] = from[i];
+}
+
+// Sort n entries using scratch (also n entries) as the other buffer; returns
+// whichever of the two holds the sorted entries
+inline uint64_t* radixSort(uint64_t* entries, uint64_t* scratch, size_t n, uint32_t max_key) {
+    for (int pass = 0; pass < radixPasses(max_key); pass++) {
+        radixPass(entries, scratch, n, radixShift(pass));
+        std::swap(entries, scratch);
+    }
+    return entries;
+}
+
+inline void radixSort(std::vector<uint64_t>& entries, uint32_t max_key) {
+    std::vector<uint64_t> scratch(entries.size());
+    if (radixSort(entries.data(), scratch.data(), entries.size(), max_key) != entries.data()) entries.swap(scratch);
+}
+
+// Fill entries[0..n-1] from key[0..n-1], with keys taken relative to the
+// smallest one so that bounded values need few passes; returns the largest
+// entry key
+inline uint32_t radixKeys(const int32_t* key, size_t n, uint64_t* entries) {
+    int32_t low = INT32_MAX, high = INT32_MIN;
+    for (size_t i = 0; i < n; i++) {
+        low = std::min(low, key[i]);
+        high = std::max(high, key[i]);
+    }
+    for (size_t i = 0; i < n; i++) entries[i] = uint64_t(uint32_t(int64_t(key[i]) - low)) << 32 | i;
+    return n > 0 ? uint32_t(int64_t(high) - low) : 0;
+}
+
+inline std::vector<uint64_t> radixEntries(const int32_t* key, size_t n, uint32_t& max_key) {
+    std::vector<uint64_t> entries(n);
+    max_key = radixKeys(key, n, entries.data());
+    return entries;
+}
+
+// Row indices of sorted entries
+inline std::vector<int32_t> radixRows(const std::vector<uint64_t>& entries) {
+    std::vector<int32_t> rows(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) rows[i] = int32_t(entries[i]);
+    return rows;
+}
+
+// Rows 0..n-1 ordered by key (row order on ties)
+inline std::vector<int32_t> sortedRows(const int32_t* key, size_t n) {
+    uint32_t max_key;
+    std::vector<uint64_t> entries = radixEntries(key, n, max_key);
+    radixSort(entries, max_key);
+    return radixRows(entries);
+}
+
+// Rows ordered by PID (row order on ties), for displaying a result without
+// materializing Process rows
+// PIDs that are unique and consecutive (the usual 1..n) need no sort: every
+// row goes straight to slot pid - lowest. Anything else is radix sorted.
+template <typename Time = int32_t>
+std::vector<int32_t> pidOrder(const ViewOf<Time>& table) {
+    size_t n = table.size();
+    const int32_t* pid = table.pid;
+    int32_t low = INT32_MAX, high = INT32_MIN;
+    for (size_t i = 0; i < n; i++) {
+        low = std::min(low, pid[i]);
+        high = std::max(high, pid[i]);
+    }
+    if (n > 0 && uint64_t(int64_t(high) - low) == n - 1) {
+        std::vector<int32_t> order(n, -1);
+        bool unique = true;
+        for (size_t i = 0; i < n && unique; i++) {
+            int32_t& slot = order[pid[i] - low];
+            unique = slot < 0;
+            slot = i;
+        }
+        if (unique) return order;
+    }
+    return sortedRows(pid, n);
+}
+
+// Join the shared inputs with one run's outputs into Process rows sorted by
+// PID, which is the order every front-end displays
+inline std::vector<Process> toProcesses(const ProcessView& table, const ScheduleResult& result) {
+    std::vector<Process> processes;
+    processes.reserve(table.size());
+    for (int32_t i : pidOrder(table)) {
+        processes.push_back({table.pid[i], table.arrival_time[i], table.burst_time[i], 0,
+                             result.completion_time[i], result.turnaround_time[i], result.waiting_time[i], true,
+                             table.priorityOf(i)});
+    }
+    return processes;
+}
+
+// True if the rows are already in arrival order (generated and logged
+// traces usually are)
+template <typename Time = int32_t>
+bool arrivalSorted(const ViewOf<Time>& table) {
+    for (size_t i = 1; i < table.size(); i++) {
+        if (table.arrival_time[i] < table.arrival_time[i - 1]) return false;
+    }
+    return true;
+}
+
+// Rows ordered by arrival time (row order on ties)
+// 32-bit times are radix sorted; wider fixed-point times use a stable sort
+template <typename Time = int32_t>
+std::vector<int32_t> arrivalOrder(const ViewOf<Time>& table) {
+    std::vector<int32_t> order(table.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    // Already sorted: the identity order is the stable order
+    if (arrivalSorted<Time>(table)) return order;
+    if constexpr (std::is_same<Time, int32_t>::value) {
+        return sortedRows(table.arrival_time, table.size());
+    } else {
+        const Time* at = table.arrival_time;
+        std::stable_sort(order.begin(), order.end(), [at](int32_t a, int32_t b) {
+            return at[a] < at[b];
+        });
+        return order;
+    }
+}
+
+// Bump allocator for the working state of engine runs
+// Allocation moves a pointer through one block and deallocation does
+// nothing; rewind() makes the whole block free again. What does not fit in
+// the block is taken from the heap and returned at the next rewind, which
+// also grows the block by that much, so a run that fitted once never
+// touches the heap again. The block is kept until its thread exits.
+// Engines reach it through ArenaScope.
+class ScratchArena : public std::pmr::memory_resource {
+public:
+    explicit ScratchArena(size_t capacity = 1 << 16) { resize(capacity); }
+    ~ScratchArena() { rewind(); }
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    size_t capacity() const { return block_size; }
+
+    // Forget every allocation; nothing allocated before may be used after
+    void rewind() {
+        for (const Spill& s : spills) std::pmr::new_delete_resource()->deallocate(s.memory, s.bytes, s.alignment);
+        spills.clear();
+        if (spilled > 0) resize(block_size + spilled);
+        spilled = 0;
+        used = 0;
+    }
+
+private:
+    friend class ArenaScope;
+
+    // Heap allocation made when the block was full
+    struct Spill {
+        void* memory;
+        size_t bytes;
+        size_t alignment;
+    };
+
+    std::unique_ptr<std::max_align_t[]> block;
+    size_t block_size = 0;
+    size_t used = 0;                    // Bytes of the block handed out
+    size_t spilled = 0;                 // Bytes (plus alignment) taken from the heap since the last rewind
+    std::vector<Spill> spills;
+    int depth = 0;                      // Open ArenaScopes on this arena
+
+    void resize(size_t bytes) {
+        size_t count = (bytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+        block.reset(new std::max_align_t[count]);
+        block_size = count * sizeof(std::max_align_t);
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.get());
+        uintptr_t start = (base + used + alignment - 1) & ~uintptr_t(alignment - 1);
+        if (start + bytes <= base + block_size) {
+            used = start + bytes - base;
+            return reinterpret_cast<void*>(start);
+        }
+        spills.reserve(spills.size() + 1);
+        void* memory = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        spills.push_back({memory, bytes, alignment});
+        spilled += bytes + alignment;
+        return memory;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// The calling thread's arena (each pool worker has its own)
+inline ScratchArena& threadArena() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+// One engine run's use of the thread's arena
+// Scopes nest (roundRobin() runs feedbackQueue(), policies run engines); the
+// outermost one rewinds the arena when it closes. Only the engine's own state
+// may live in the arena: results, and anything that outlives the run, use
+// the ordinary heap.
+class ArenaScope {
+public:
+    ArenaScope() : arena(threadArena()) { arena.depth++; }
+    ~ArenaScope() {
+        if (--arena.depth == 0) arena.rewind();
+    }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    std::pmr::memory_resource* memory() { return &arena; }
+
+private:
+    ScratchArena& arena;
+};
+
+// Arrival order as used by the engines: order[i] is the i-th row to arrive
+// A table that is already sorted needs no permutation, so the engines use no
+// per-row memory for it. The permutation and its sort buffers come from
+// memory (an engine's arena; the heap by default).
+class ArrivalOrder {
+public:
+    template <typename Time>
+    explicit ArrivalOrder(const BasicProcessView<Time>& table,
+                          std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : rows(memory) {
+        if (arrivalSorted<Time>(table)) return;
+        size_t n = table.size();
+        if constexpr (std::is_same<Time, int32_t>::value) {
+            std::pmr::vector<uint64_t> entries(n, memory), scratch(n, memory);
+            uint32_t max_key = radixKeys(table.arrival_time, n, entries.data());
+            const uint64_t* sorted = radixSort(entries.data(), scratch.data(), n, max_key);
+            rows.resize(n);
+            for (size_t i = 0; i < n; i++) rows[i] = int32_t(sorted[i]);
+        } else {
+            std::vector<int32_t> order = arrivalOrder<Time>(table);
+            rows.assign(order.begin(), order.end());
+        }
+        permutation = rows.data();
+    }
+    ArrivalOrder(const ArrivalOrder&) = delete;
+    ArrivalOrder& operator=(const ArrivalOrder&) = delete;
+
+    int32_t operator[](size_t i) const { return permutation ? permutation[i] : int32_t(i); }
+
+private:
+    std::pmr::vector<int32_t> rows;     // Empty when the table is sorted
+    const int32_t* permutation = nullptr;
+};
+
+// FIFO ring buffer used as the RR ready queue
+// Starts at the given capacity and doubles when full, so it only grows to
+// the longest the queue ever gets, not to the number of processes
+template <typename T>
+struct RingQueue {
+    std::pmr::vector<T> slots; // Storage, sized to a power of two
+    size_t mask;               // slots.size() - 1, used to wrap positions
+    size_t head = 0;           // Position of the front element
+    size_t tail = 0;           // Position one past the back element
+
+    // Create a queue able to hold at least capacity elements before growing
+    explicit RingQueue(size_t capacity = 16, std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : slots(memory) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        slots.resize(size);
+        mask = size - 1;
+    }
+    bool empty() const { return head == tail; }
+    size_t size() const { return tail - head; }
+    void push(const T& value) {
+        if (tail - head == slots.size()) grow();
+        slots[tail++ & mask] = value;
+    }
+    const T& front() const { return slots[head & mask]; }
+    T pop() { return slots[head++ & mask]; }
+
+private:
+    // Unwrap into twice the storage, front element first
+    void grow() {
+        std::pmr::vector<T> bigger(2 * slots.size(), slots.get_allocator());
+        for (size_t i = head; i != tail; i++) bigger[i - head] = slots[i & mask];
+        tail -= head;
+        head = 0;
+        slots.swap(bigger);
+        mask = slots.size() - 1;
+    }
+};
+
+// Binary min-heap over row indices 0..n-1 with a position index per row
+// Keys are ordered by operator< with ties going to the lower row. The index
+// makes contains() O(1) and lets decreaseKey() move an entry up in place in
+// O(log n), with no rebuild and no stale duplicates. Pushing a row past n
+// grows the index, so n can start at 0 when rows are handed out on demand.
+template <typename Key = int64_t>
+class IndexedHeap {
+public:
+    explicit IndexedHeap(size_t n, std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : heap(memory), key(n, memory), position(n, -1, memory) {
+        heap.reserve(n);
+    }
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    bool contains(int32_t row) const { return position[row] >= 0; }
+    int32_t top() const { return heap[0]; }
+    const Key& keyOf(int32_t row) const { return key[row]; }
+
+    void push(int32_t row, const Key& k) {
+        if (size_t(row) >= key.size()) {
+            key.resize(row + 1);
+            position.resize(row + 1, -1);
+        }
+        key[row] = k;
+        position[row] = heap.size();
+        heap.push_back(row);
+        siftUp(heap.size() - 1);
+    }
+
+    int32_t pop() {
+        int32_t row = heap[0];
+        place(0, heap.back());
+        heap.pop_back();
+        position[row] = -1;
+        if (!heap.empty()) siftDown(0);
+        return row;
+    }
+
+    // Lower the key of a queued row (k must not be larger than its key)
+    void decreaseKey(int32_t row, const Key& k) {
+        key[row] = k;
+        siftUp(position[row]);
+    }
+
+private:
+    std::pmr::vector<int32_t> heap;     // Rows in heap order
+    std::pmr::vector<Key> key;          // Key per row
+    std::pmr::vector<int32_t> position; // Heap slot per row, -1 if not queued
+
+    bool less(int32_t a, int32_t b) const {
+        if (key[a] < key[b]) return true;
+        if (key[b] < key[a]) return false;
+        return a < b;
+    }
+
+    void place(size_t slot, int32_t row) {
+        heap[slot] = row;
+        position[row] = slot;
+    }
+
+    void siftUp(size_t slot) {
+        int32_t row = heap[slot];
+        while (slot > 0 && less(row, heap[(slot - 1) / 2])) {
+            place(slot, heap[(slot - 1) / 2]);
+            slot = (slot - 1) / 2;
+        }
+        place(slot, row);
+    }
+
+    void siftDown(size_t slot) {
+        int32_t row = heap[slot];
+        for (;;) {
+            size_t child = 2 * slot + 1;
+            if (child >= heap.size()) break;
+            if (child + 1 < heap.size() && less(heap[child + 1], heap[child])) child++;
+            if (!less(heap[child], row)) break;
+            place(slot, heap[child]);
+            slot = child;
+        }
+        place(slot, row);
+    }
+};
+
+// FCFS as a prefix scan
+// With S[i] the running sum of the charged bursts, the recurrence
+// ct[i] = max(ct[i-1], at[i]) + bt[i] has the closed form
+// ct[i] = S[i] + max over j <= i of (at[j] - S[j-1]), i.e. a running sum and a
+// running max, which can be computed several rows at a time and split into
+// chunks that are scanned independently and stitched together by their carries.
+// The carry holds S and the running max at the end of the rows scanned so far.
+struct FcfsCarry {
+    int32_t sum = 0;
+    int32_t best = INT32_MIN;
+};
+
+// Scan n rows in arrival order, charging extra on top of every burst, and
+// write completion times to ct (or only update the carry if ct is null)
+inline void fcfsScanScalar(const int32_t* at, const int32_t* bt, size_t n, int32_t extra, int32_t* ct,
+                           FcfsCarry& carry) {
+    int32_t sum = carry.sum, best = carry.best;
+    for (size_t i = 0; i < n; i++) {
+        best = std::max(best, at[i] - sum);
+        sum += bt[i] + extra;
+        if (ct) ct[i] = sum + best;
+    }
+    carry.sum = sum;
+    carry.best = best;
+}
+
+#ifdef SCHEDULING_HAVE_AVX2_DISPATCH
+// Eight rows per step: in-register prefix sum and prefix max, then the carry
+// from the previous step is added/maxed into every lane
+__attribute__((target("avx2")))
+inline void fcfsScanAvx2(const int32_t* at, const int32_t* bt, size_t n, int32_t extra, int32_t* ct,
+                         FcfsCarry& carry) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lowest = _mm256_set1_epi32(INT32_MIN);
+    const __m256i charge = _mm256_set1_epi32(extra);
+    const __m256i last_lane = _mm256_set1_epi32(7);
+    __m256i sum = _mm256_set1_epi32(carry.sum);
+    __m256i best = _mm256_set1_epi32(carry.best);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i b = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(bt + i)), charge);
+        __m256i a = _mm256_loadu_si256((const __m256i*)(at + i));
+
+        // Inclusive prefix sum of b: within each 128-bit half, then carry
+        // the low half's total into the high half
+        __m256i s = _mm256_add_epi32(b, _mm256_slli_si256(b, 4));
+        s = _mm256_add_epi32(s, _mm256_slli_si256(s, 8));
+        s = _mm256_add_epi32(s, _mm256_permute2x128_si256(zero, _mm256_shuffle_epi32(s, 0xFF), 0x20));
+        s = _mm256_add_epi32(s, sum);
+
+        // at[j] - S[j-1], then its inclusive prefix max the same way
+        __m256i x = _mm256_sub_epi32(a, _mm256_sub_epi32(s, b));
+        x = _mm256_max_epi32(x, _mm256_alignr_epi8(x, lowest, 12));
+        x = _mm256_max_epi32(x, _mm256_alignr_epi8(x, lowest, 8));
+        x = _mm256_max_epi32(x, _mm256_permute2x128_si256(lowest, _mm256_shuffle_epi32(x, 0xFF), 0x20));
+        x = _mm256_max_epi32(x, best);
+
+        if (ct) _mm256_storeu_si256((__m256i*)(ct + i), _mm256_add_epi32(s, x));
+        sum = _mm256_permutevar8x32_epi32(s, last_lane);
+        best = _mm256_permutevar8x32_epi32(x, last_lane);
+    }
+    carry.sum = _mm256_cvtsi256_si32(sum);
+    carry.best = _mm256_cvtsi256_si32(best);
+    fcfsScanScalar(at + i, bt + i, n - i, extra, ct ? ct + i : nullptr, carry);
+}
+#endif
+
+// Scan with the widest kernel the CPU supports
+inline void fcfsScan(const int32_t* at, const int32_t* bt, size_t n, int32_t extra, int32_t* ct, FcfsCarry& carry) {
+#ifdef SCHEDULING_HAVE_AVX2_DISPATCH
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2) {
+        fcfsScanAvx2(at, bt, n, extra, ct, carry);
+        return;
+    }
+#endif
+    fcfsScanScalar(at, bt, n, extra, ct, carry);
+}
+
+// True if no running sum of the scan can overflow 32 bits
+inline bool fcfsScanFits(const ProcessView& table, int switch_cost) {
+    int64_t latest = 0, total = 0;
+    for (size_t i = 0; i < table.size(); i++) {
+        latest = std::max<int64_t>(latest, table.arrival_time[i]);
+        total += table.burst_time[i];
+    }
+    return latest + total + int64_t(switch_cost) * table.size() <= INT32_MAX;
+}
+
+// Fill TAT/WT from CT and charge one switch per dispatch after the first
+// (consecutive FCFS dispatches are always different processes)
+inline void fcfsFinish(const ProcessView& table, ScheduleResult& result, size_t first, size_t last, int switch_cost) {
+    const int32_t* at = table.arrival_time;
+    const int32_t* bt = table.burst_time;
+    for (size_t i = first; i < last; i++) {
+        result.turnaround_time[i] = result.completion_time[i] - at[i];
+        result.waiting_time[i] = result.turnaround_time[i] - bt[i];
+    }
+    if (first == 0 && table.size() > 0) {
+        result.context_switches = table.size() - 1;
+        result.switch_overhead = int64_t(switch_cost) * (table.size() - 1);
+    }
+}
+
+// First Come First Served (FCFS) - Non-preemptive
+// The recurrence from fcfs.cpp over processes in arrival order:
+// CT = max(previous CT, AT) + BT
+// Without a Gantt chart it runs as the 32-bit prefix scan above when
+// fcfsScanFits() proves no sum can overflow; otherwise it steps through the
+// processes one at a time (timelines, streaming runs, fixed-point times and
+// traces the bound cannot clear). In 32-bit times that loop keeps the clock in
+// 64 bits and throws std::overflow_error once a completion does not fit.
+template <typename Time = int32_t>
+BasicScheduleResult<Time> fcfs(const ViewOf<Time>& table, GanttOf<Time>* gantt = nullptr, TimeOf<Time> switch_cost = 0,
+                               SinkOf<Time>* sink = nullptr) {
+    int n = table.size();
+    BasicScheduleResult<Time> result(n, sink);
+    ArenaScope scope;
+    const Time* at = table.arrival_time;
+    const Time* bt = table.burst_time;
+
+    if constexpr (std::is_same<Time, int32_t>::value) {
+        if (!gantt && !sink && n > 0 && fcfsScanFits(table, switch_cost)) {
+            // Rows out of arrival order are gathered into order first
+            bool sorted = arrivalSorted(table);
+            ArrivalOrder order(table, scope.memory());
+            std::pmr::vector<int32_t> sorted_at(scope.memory()), sorted_bt(scope.memory()), sorted_ct(scope.memory());
+            const int32_t* a = at;
+            const int32_t* b = bt;
+            int32_t* ct = result.completion_time.data();
+            if (!sorted) {
+                sorted_at.resize(n);
+                sorted_bt.resize(n);
+                sorted_ct.resize(n);
+                for (int i = 0; i < n; i++) {
+                    sorted_at[i] = at[order[i]];
+                    sorted_bt[i] = bt[order[i]];
+                }
+                a = sorted_at.data();
+                b = sorted_bt.data();
+                ct = sorted_ct.data();
+            }
+            // The first process is never charged a switch
+            FcfsCarry carry;
+            carry.best = a[0];
+            carry.sum = b[0];
+            ct[0] = a[0] + b[0];
+            fcfsScan(a + 1, b + 1, n - 1, switch_cost, ct + 1, carry);
+            if (!sorted) {
+                for (int i = 0; i < n; i++) result.completion_time[order[i]] = sorted_ct[i];
+            }
+            fcfsFinish(table, result, 0, n, switch_cost);
+            return result;
+        }
+    }
+
+    ArrivalOrder order(table, scope.memory());
+    typedef typename std::conditional<std::is_same<Time, int32_t>::value, int64_t, Time>::type Clock;
+    Clock current_time = 0;
+    int32_t last_row = -1;
+    for (int i = 0; i < n; i++) {
+        int32_t row = order[i];
+        // Idle until the process arrives if the CPU is free before then
+        current_time = std::max<Clock>(current_time, at[row]);
+        Time latency = result.dispatch(row, last_row, switch_cost);
+        if constexpr (std::is_same<Time, int32_t>::value) {
+            if (current_time + latency + bt[row] > INT32_MAX) {
+                throw std::overflow_error("FCFS completion times do not fit in 32 bits");
+            }
+        }
+        if (gantt) gantt->record(GANTT_SWITCH, current_time, current_time + latency);
+        current_time += latency;
+        result.start(table, row, current_time);
+        if (gantt) gantt->record(table.pid[row], current_time, current_time + bt[row]);
+        current_time += bt[row];
+        result.complete(table, row, current_time);
+    }
+    return result;
+}
+
+// Shortest Job First (SJF) - Non-preemptive
+// Arrived processes wait in a min-heap keyed on (burst, arrival, pid): the
+// shortest burst runs first, ties go to the earlier arrival, then the lower PID
+// switch_cost is the dispatch latency charged on every context switch
+template <typename Time = int32_t>
+BasicScheduleResult<Time> sjf(const ViewOf<Time>& table, GanttOf<Time>* gantt = nullptr, TimeOf<Time> switch_cost = 0,
+                              SinkOf<Time>* sink = nullptr) {
+    int n = table.size();
+    BasicScheduleResult<Time> result(n, sink);
+    ArenaScope scope;
+    ArrivalOrder order(table, scope.memory());
+    const Time* at = table.arrival_time;
+    const Time* bt = table.burst_time;
+
+    // Heap entry: (burst time, arrival time, pid, row)
+    typedef std::tuple<Time, Time, int32_t, int32_t> Job;
+    std::priority_queue<Job, std::pmr::vector<Job>, std::greater<Job>> ready{std::greater<Job>(),
+                                                                             std::pmr::vector<Job>(scope.memory())};
+    Time current_time = 0;
+    int next = 0;
+    int32_t last_row = -1;
+
+    for (int i = 0; i < n; i++) {
+        // If no process is waiting, jump to the next arrival time
+        if (ready.empty() && at[order[next]] > current_time) {
+            current_time = at[order[next]];
+        }
+        while (next < n && at[order[next]] <= current_time) {
+            int32_t row = order[next];
+            ready.push(std::make_tuple(bt[row], at[row], table.pid[row], row));
+            next++;
+        }
+
+        int32_t row = std::get<3>(ready.top());
+        ready.pop();
+        Time latency = result.dispatch(row, last_row, switch_cost);
+        if (gantt) gantt->record(GANTT_SWITCH, current_time, current_time + latency);
+        current_time += latency;
+        result.start(table, row, current_time);
+        if (gantt) gantt->record(table.pid[row], current_time, current_time + bt[row]);
+        current_time += bt[row];
+        result.complete(table, row, current_time);
+    }
+    return result;
+}
+
+// Shortest Remaining Time First (SRTF) - Preemptive
+// Event-driven: time only advances to the next arrival or completion, so the
+// cost grows with the number of processes, not with the total burst time
+// A switch's latency cannot be interrupted: processes arriving during it are
+// only considered once the dispatched process has run to the next event
+template <typename Time = int32_t>
+BasicScheduleResult<Time> srtf(const ViewOf<Time>& table, GanttOf<Time>* gantt = nullptr, TimeOf<Time> switch_cost = 0,
+                               SinkOf<Time>* sink = nullptr) {
+    int n = table.size();
+    BasicScheduleResult<Time> result(n, sink);
+    ArenaScope scope;
+    ArrivalOrder order(table, scope.memory());
+    const Time* at = table.arrival_time;
+    const Time* bt = table.burst_time;
+
+    // Min-heap of (remaining time, row) for arrived processes; ties go to the
+    // lower row, exactly like the original tick-by-tick scan did. Remaining
+    // time lives in the heap entry, so no per-row scratch column is needed.
+    typedef std::pair<Time, int32_t> Job;
+    std::priority_queue<Job, std::pmr::vector<Job>, std::greater<Job>> ready{std::greater<Job>(),
+                                                                             std::pmr::vector<Job>(scope.memory())};
+    Time current_time = 0;
+    int next = 0;
+    int completed = 0;
+    int32_t last_row = -1;
+
+    while (completed < n) {
+        // If nothing is ready, jump straight to the next arrival time
+        if (ready.empty() && at[order[next]] > current_time) {
+            current_time = at[order[next]];
+        }
+        while (next < n && at[order[next]] <= current_time) {
+            ready.push({bt[order[next]], order[next]});
+            next++;
+        }
+
+        Job job = ready.top();
+        ready.pop();
+        Time latency = result.dispatch(job.second, last_row, switch_cost);
+        if (latency > 0) {
+            if (gantt) gantt->record(GANTT_SWITCH, current_time, current_time + latency);
+            current_time += latency;
+            // Queue whatever arrived while switching
+            while (next < n && at[order[next]] <= current_time) {
+                ready.push({bt[order[next]], order[next]});
+                next++;
+            }
+        }
+        // Every slice runs for at least one time unit, so a job that still
+        // has its whole burst left has never run
+        if (job.first == bt[job.second]) result.start(table, job.second, current_time);
+
+        // Run until it completes or the next process arrives, whichever is first
+        Time run_until = current_time + job.first;
+        if (next < n && at[order[next]] < run_until) {
+            run_until = at[order[next]];
+        }
+        job.first -= run_until - current_time;
+        if (gantt) gantt->record(table.pid[job.second], current_time, run_until);
+        current_time = run_until;
+
+        if (job.first == 0) {
+            result.complete(table, job.second, current_time);
+            completed++;
+        } else {
+            // Preempted by an arrival: put it back with its new remaining time
+            ready.push(job);
+        }
+    }
+    return result;
+}
+
+// Priority scheduling with aging - lower priority value runs first
+// Ties go to the earlier arrival, then the lower row. With aging_interval > 0
+// a waiting process gains one level (down to 0) for every aging_interval time
+// units it spends in the ready queue, so low-priority work cannot starve.
+// Every waiting process has one pending aging deadline, and deadlines are
+// created in time order, so they wait in a FIFO; each aging step is a single
+// O(log n) decreaseKey on the indexed ready heap, never a rescan.
+// Preemptive: a process that arrives or ages to a strictly better priority
+// takes the CPU; the preempted one keeps the priority it had reached. As in
+// srtf(), a switch's latency cannot be interrupted.
+template <typename Time = int32_t>
+BasicScheduleResult<Time> priorityScheduling(const ViewOf<Time>& table, bool preemptive, TimeOf<Time> aging_interval = 0,
+                                             GanttOf<Time>* gantt = nullptr, TimeOf<Time> switch_cost = 0,
+                                             SinkOf<Time>* sink = nullptr) {
+    int n = table.size();
+    BasicScheduleResult<Time> result(n, sink);
+    ArenaScope scope;
+    std::pmr::memory_resource* memory = scope.memory();
+    ArrivalOrder order(table, memory);
+    const Time* at = table.arrival_time;
+    const Time* bt = table.burst_time;
+
+    // In-flight processes live in slots that are recycled on completion, so
+    // the state grows with the processes waiting or running at once, not with
+    // the length of the trace
+    struct Job {
+        int32_t row;
+        int32_t priority;       // Current (aged) priority
+        Time remaining;
+        int32_t generation;     // Bumped on every enqueue, to spot stale deadlines
+    };
+    std::pmr::vector<Job> jobs(memory);
+    std::pmr::vector<int32_t> free_slots(memory);
+
+    // Key (priority, arrival, row); 32-bit times pack the first two into one
+    // int64. The row decides ties, as slot numbers say nothing about order.
+    typedef typename std::conditional<sizeof(Time) <= 4, std::pair<int64_t, int32_t>,
+                                      std::tuple<int32_t, Time, int32_t>>::type Key;
+    IndexedHeap<Key> ready(0, memory);
+    auto key = [&](int32_t slot) {
+        const Job& job = jobs[slot];
+        if constexpr (sizeof(Time) <= 4) {
+            return Key(int64_t(job.priority) * (int64_t(1) << 32) + at[job.row], job.row);
+        } else {
+            return Key(job.priority, at[job.row], job.row);
+        }
+    };
+
+    // Pending aging deadline of a waiting process
+    struct Deadline {
+        int64_t time;
+        int32_t slot;
+        int32_t generation;
+    };
+    RingQueue<Deadline> aging(16, memory);
+    int next = 0;
+
+    // Put a slot in the ready queue at time t and schedule its first aging step
+    auto enqueue = [&](int32_t slot, int64_t t) {
+        Job& job = jobs[slot];
+        ready.push(slot, key(slot));
+        job.generation++;
+        if (aging_interval > 0 && job.priority > 0) aging.push({t + aging_interval, slot, job.generation});
+    };
+
+    // Give an arriving row a slot, reusing one freed by a completion
+    auto admit = [&](int32_t row) {
+        int32_t slot;
+        if (free_slots.empty()) {
+            slot = jobs.size();
+            jobs.push_back({row, 0, 0, 0});
+        } else {
+            slot = free_slots.back();
+            free_slots.pop_back();
+        }
+        jobs[slot].row = row;
+        jobs[slot].priority = table.priorityOf(row);
+        jobs[slot].remaining = bt[row];
+        return slot;
+    };
+
+    // Apply every arrival and aging deadline up to time t, in time order
+    auto advanceTo = [&](int64_t t) {
+        for (;;) {
+            int64_t arrival = next < n ? at[order[next]] : INT64_MAX;
+            int64_t deadline = aging.empty() ? INT64_MAX : aging.front().time;
+            if (std::min(arrival, deadline) > t) break;
+            if (arrival <= deadline) {
+                enqueue(admit(order[next]), arrival);
+                next++;
+                continue;
+            }
+            Deadline d = aging.pop();
+            // Skip deadlines of processes that have run (or finished) since
+            // they were set
+            Job& job = jobs[d.slot];
+            if (!ready.contains(d.slot) || job.generation != d.generation) continue;
+            job.priority--;
+            ready.decreaseKey(d.slot, key(d.slot));
+            if (job.priority > 0) aging.push({d.time + aging_interval, d.slot, d.generation});
+        }
+    };
+
+    int completed = 0;
+    int32_t last_row = -1;
+    int64_t current_time = n > 0 ? at[order[0]] : 0;
+    while (completed < n) {
+        advanceTo(current_time);
+        // If nothing is ready, jump straight to the next arrival time
+        if (ready.empty()) {
+            current_time = at[order[next]];
+            continue;
+        }
+
+        int32_t slot = ready.pop();
+        int32_t row = jobs[slot].row;
+        Time latency = result.dispatch(row, last_row, switch_cost);
+        if (gantt) gantt->record(GANTT_SWITCH, current_time, current_time + latency);
+        current_time += latency;
+        // Queue whatever arrived or aged while switching
+        advanceTo(current_time);
+        if (jobs[slot].remaining == bt[row]) result.start(table, row, current_time);
+
+        // Run until completion or, if preemptive, until an arrival or aging
+        // step puts a better process at the top of the queue
+        for (;;) {
+            int64_t finish = current_time + jobs[slot].remaining;
+            int64_t until = finish;
+            if (preemptive) {
+                int64_t arrival = next < n ? at[order[next]] : INT64_MAX;
+                int64_t deadline = aging.empty() ? INT64_MAX : aging.front().time;
+                until = std::min(until, std::min(arrival, deadline));
+            }
+            if (gantt) gantt->record(table.pid[row], current_time, until);
+            jobs[slot].remaining -= until - current_time;
+            current_time = until;
+            if (until == finish) break;
+            advanceTo(current_time);
+            // Only a strictly better priority preempts; an earlier arrival at
+            // the same priority waits, or two aging jobs would trade the CPU
+            if (!ready.empty() && jobs[ready.top()].priority < jobs[slot].priority) break;
+        }
+
+        if (jobs[slot].remaining == 0) {
+            result.complete(table, row, current_time);
+            completed++;
+            free_slots.push_back(slot);
+        } else {
+            // Preempted: back to the queue with its current priority
+            enqueue(slot, current_time);
+        }
+    }
+    return result;
+}
+
+// Multilevel Feedback Queue (MLFQ) - Preemptive
+// Level i is a FIFO ring with time slice quanta[i]. Arrivals enter the top
+// level; a process that uses its whole slice moves down one level (the last
+// level keeps it), so long jobs sink and short ones finish near the top
+// without knowing any burst time in advance. A slice on a lower level is cut
+// short when a process arrives, and the interrupted process goes to the back
+// of its own level. Every boost_interval time units (0 = never) all waiting
+// processes are moved back to the top level, so sunk jobs cannot starve.
+// Processes arriving during a switch's latency are queued after the slice,
+// like those arriving during the slice itself
+// This runs levels levels with slices quanta[0..levels-1]; the per-level
+// counters are only copied into the result if keep_levels is set.
+template <typename Time>
+BasicScheduleResult<Time> runFeedbackQueue(const ViewOf<Time>& table, const Time* quanta, int levels,
+                                           Time boost_interval, GanttOf<Time>* gantt, Time switch_cost,
+                                           SinkOf<Time>* sink, bool keep_levels) {
+    int n = table.size();
+    BasicScheduleResult<Time> result(n, sink);
+    ArenaScope scope;
+    std::pmr::memory_resource* memory = scope.memory();
+    std::pmr::vector<LevelStats> counters(levels, memory);
+    for (int l = 0; l < levels; l++) counters[l].quantum = quanta[l];
+    ArrivalOrder order(table, memory);
+    const Time* at = table.arrival_time;
+    const Time* bt = table.burst_time;
+
+    // Queue entry: (row, remaining time); one ring per level
+    typedef std::pair<int32_t, Time> Job;
+    std::pmr::vector<RingQueue<Job>> queues(memory);
+    queues.reserve(levels);
+    for (int l = 0; l < levels; l++) queues.emplace_back(16, memory);
+    int completed = 0;
+    int next = 0;
+    int32_t last_row = -1;
+    std::pmr::vector<int32_t> arrived(memory);
+
+    // Enqueue every process that has arrived by time t at the top level, in
+    // row order (the order the original full scan over all processes used)
+    auto admit = [&](Time t) {
+        arrived.clear();
+        while (next < n && at[order[next]] <= t) {
+            arrived.push_back(order[next]);
+            next++;
+        }
+        std::sort(arrived.begin(), arrived.end());
+        for (int32_t row : arrived) queues[0].push({row, bt[row]});
+    };
+
+    Time current_time = n > 0 ? at[order[0]] : 0;
+    int64_t next_boost = boost_interval > 0 ? int64_t(current_time) + boost_interval : INT64_MAX;
+    admit(current_time);
+
+    while (completed < n) {
+        // Highest non-empty level; if all are empty, jump to the next arrival
+        int level = 0;
+        while (level < levels && queues[level].empty()) level++;
+        if (level == levels) {
+            current_time = at[order[next]];
+            admit(current_time);
+            level = 0;
+        }
+
+        Job job = queues[level].pop();
+        LevelStats& stats = counters[level];
+        stats.dispatches++;
+        Time latency = result.dispatch(job.first, last_row, switch_cost);
+        if (gantt) gantt->record(GANTT_SWITCH, current_time, current_time + latency);
+        current_time += latency;
+        if (job.second == bt[job.first]) result.start(table, job.first, current_time);
+        Time execute_time = std::min(quanta[level], job.second);
+        bool preempted = false;
+        if (level > 0) {
+            // Stop at the first arrival after the latency, if it comes first
+            int k = next;
+            while (k < n && at[order[k]] <= current_time) k++;
+            if (k < n && at[order[k]] < current_time + execute_time) {
+                execute_time = at[order[k]] - current_time;
+                preempted = true;
+            }
+        }
+        if (gantt) gantt->record(table.pid[job.first], current_time, current_time + execute_time);
+        current_time += execute_time;
+        stats.run_time += execute_time;
+        job.second -= execute_time;
+
+        // Newly arrived processes go in before the preempted one is re-queued
+        admit(current_time);
+
+        if (job.second == 0) {
+            result.complete(table, job.first, current_time);
+            stats.completions++;
+            completed++;
+        } else if (preempted) {
+            stats.preemptions++;
+            queues[level].push(job);
+        } else if (level + 1 < levels) {
+            stats.demotions++;
+            queues[level + 1].push(job);
+        } else {
+            queues[level].push(job);
+        }
+
+        // Periodic boost: lower levels drain to the top in level order
+        if (current_time >= next_boost) {
+            for (int l = 1; l < levels; l++) {
+                while (!queues[l].empty()) {
+                    queues[0].push(queues[l].pop());
+                    counters[l].boosts++;
+                }
+            }
+            next_boost += (current_time - next_boost) / boost_interval * boost_interval + boost_interval;
+        }
+    }
+    if (keep_levels) result.levels.assign(counters.begin(), counters.end());
+    return result;
+}
+
+// MLFQ with one level per time slice in quanta
+template <typename Time = int32_t>
+BasicScheduleResult<Time> feedbackQueue(const ViewOf<Time>& table, const std::vector<TimeOf<Time>>& quanta,
+                                        TimeOf<Time> boost_interval = 0, GanttOf<Time>* gantt = nullptr,
+                                        TimeOf<Time> switch_cost = 0, SinkOf<Time>* sink = nullptr) {
+    return runFeedbackQueue<Time>(table, quanta.data(), quanta.size(), boost_interval, gantt, switch_cost, sink, true);
+}
+
+// Round Robin (RR) with time quantum
+// A feedback queue with a single level: every slice goes back to the tail
+template <typename Time = int32_t>
+BasicScheduleResult<Time> roundRobin(const ViewOf<Time>& table, TimeOf<Time> quantum, GanttOf<Time>* gantt = nullptr,
+                                     TimeOf<Time> switch_cost = 0, SinkOf<Time>* sink = nullptr) {
+    return runFeedbackQueue<Time>(table, &quantum, 1, 0, gantt, switch_cost, sink, false);
+}
+
+// Time slices for an MLFQ with the given number of levels: top_quantum at the
+// top level, doubling on every level below it
+inline std::vector<int> mlfqQuanta(int top_quantum, int levels) {
+    std::vector<int> quanta;
+    for (int l = 0; l < levels; l++) quanta.push_back(std::max(top_quantum, 1) << std::min(l, 20));
+    return quanta;
+}
+
+// Median of the burst column, rounded to a whole quantum (a whole tick for
+// fixed-point times)
+template <typename Time = int32_t>
+Time calculateOptimalQuantum(const ViewOf<Time>& table) {
+    int n = table.size();
+    std::vector<Time> burst_times(table.burst_time, table.burst_time + n);
+    // Selection instead of a full sort: only the middle element(s) matter
+    std::nth_element(burst_times.begin(), burst_times.begin() + n/2, burst_times.end());
+    double median = burst_times[n/2];
+    if (n % 2 == 0) {
+        // Even count: average with the largest element of the lower half
+        median = (*std::max_element(burst_times.begin(), burst_times.begin() + n/2) + median) / 2.0;
+    }
+    Time quantum = std::round(median);
+    // At least 1 to avoid division by zero
+    return (quantum > 0) ? quantum : 1;
+}
+
+// Mean of the burst column, rounded to a whole quantum
+inline int calculateMeanQuantum(const ProcessView& table) {
+    double sum = 0;
+    for (size_t i = 0; i < table.size(); i++) sum += table.burst_time[i];
+    int quantum = std::round(sum / table.size());
+    return (quantum > 0) ? quantum : 1;
+}
+
+// Pluggable scheduling policy: each algorithm is one subclass, so front-ends
+// can hold a list of policies and run them the same way
+class SchedulingPolicy {
+public:
+    virtual ~SchedulingPolicy() {}
+    // Display name, e.g. "Shortest Job First (SJF)"
+    virtual std::string name() const = 0;
+    // Schedule the shared table and return this run's output columns,
+    // recording the timeline into gantt if it is not null; with a sink,
+    // completions are streamed to it and the columns are left empty
+    virtual ScheduleResult schedule(const ProcessView& table, GanttChart* gantt = nullptr,
+                                    CompletionSink* sink = nullptr) const = 0;
+};
+
+class FcfsPolicy : public SchedulingPolicy {
+public:
+    explicit FcfsPolicy(int switch_cost = 0) : switch_cost(switch_cost) {}
+    std::string name() const override { return "First Come First Served (FCFS)"; }
+    ScheduleResult schedule(const ProcessView& table, GanttChart* gantt = nullptr,
+                            CompletionSink* sink = nullptr) const override {
+        return fcfs(table, gantt, switch_cost, sink);
+    }
+    int switchCost() const { return switch_cost; }
+private:
+    int switch_cost;
+};
+
+class SjfPolicy : public SchedulingPolicy {
+public:
+    explicit SjfPolicy(int switch_cost = 0) : switch_cost(switch_cost) {}
+    std::string name() const override { return "Shortest Job First (SJF)"; }
+    ScheduleResult schedule(const ProcessView& table, GanttChart* gantt = nullptr,
+                            CompletionSink* sink = nullptr) const override {
+        return sjf(table, gantt, switch_cost, sink);
+    }
+private:
+    int switch_cost;
+};
+
+class SrtfPolicy : public SchedulingPolicy {
+public:
+    explicit SrtfPolicy(int switch_cost = 0) : switch_cost(switch_cost) {}
+    std::string name() const override { return "Shortest Remaining Time First (SRTF)"; }
+    ScheduleResult schedule(const ProcessView& table, GanttChart* gantt = nullptr,
+                            CompletionSink* sink = nullptr) const override {
+        return srtf(table, gantt, switch_cost, sink);
+    }
+private:
+    int switch_cost;
+};
+
+class RoundRobinPolicy : public SchedulingPolicy {
+public:
+    explicit RoundRobinPolicy(int quantum, int switch_cost = 0) : quantum(quantum), switch_cost(switch_cost) {}
+    std::string name() const override { return "Round Robin (RR) - Quantum: " + std::to_string(quantum); }
+    ScheduleResult schedule(const ProcessView& table, GanttChart* gantt = nullptr,
+                            CompletionSink* sink = nullptr) const override {
+        return roundRobin(table, quantum, gantt, switch_cost, sink);
+    }
+private:
+    int quantum;
+    int switch_cost;
+};
+
+class MlfqPolicy : public SchedulingPolicy {
+public:
+    // boost_interval 0 picks ten slices of the lowest level
+    explicit MlfqPolicy(std::vector<int> quanta, int boost_interval = 0, int switch_cost = 0)
+        : quanta(quanta), boost_interval(boost_interval > 0 ? boost_interval : 10 * quanta.back()), switch_cost(switch_cost) {}
+    std::string name() const override {
+        std::string list;
+        for (int q : quanta) list += (list.empty() ? "" : "/") + std::to_string(q);
+        return "Multilevel Feedback Queue (MLFQ) - Quanta: " + list + ", Boost: " + std::to_string(boost_interval);
+    }
+    ScheduleResult schedule(const ProcessView& table, GanttChart* gantt = nullptr,
+                            CompletionSink* sink = nullptr) const override {
+        return feedbackQueue(table, quanta, boost_interval, gantt, switch_cost, sink);
+    }
+private:
+    std::vector<int> quanta;
+    int boost_interval;
+    int switch_cost;
+};
+
+class PriorityPolicy : public SchedulingPolicy {
+public:
+    // aging_interval 0 disables aging
+    PriorityPolicy(bool preemptive, int aging_interval = 0, int switch_cost = 0)
+        : preemptive(preemptive), aging_interval(aging_interval), switch_cost(switch_cost) {}
+    std::string name() const override {
+        return std::string("Priority (") + (preemptive ? "Preemptive" : "Non-preemptive") + ") - Aging: " +
+               (aging_interval > 0 ? std::to_string(aging_interval) : "off");
+    }
+    ScheduleResult schedule(const ProcessView& table, GanttChart* gantt = nullptr,
+                            CompletionSink* sink = nullptr) const override {
+        return priorityScheduling(table, preemptive, aging_interval, gantt, switch_cost, sink);
+    }
+private:
+    bool preemptive;
+    int aging_interval;
+    int switch_cost;
+};
+
+// Policy by short name ("fcfs", "sjf", "srtf", "rr", "mlfq", "priority" or
+// "ppriority"), or nullptr if unknown
+// MLFQ gets three levels with quantum as the top slice; the priority policies
+// age waiting processes by one level every quantum
+inline std::unique_ptr<SchedulingPolicy> makePolicy(const std::string& name, int quantum, int switch_cost = 0) {
+    if (name == "fcfs") return std::unique_ptr<SchedulingPolicy>(new FcfsPolicy(switch_cost));
+    if (name == "sjf") return std::unique_ptr<SchedulingPolicy>(new SjfPolicy(switch_cost));
+    if (name == "srtf") return std::unique_ptr<SchedulingPolicy>(new SrtfPolicy(switch_cost));
+    if (name == "rr") return std::unique_ptr<SchedulingPolicy>(new RoundRobinPolicy(quantum, switch_cost));
+    if (name == "mlfq") return std::unique_ptr<SchedulingPolicy>(new MlfqPolicy(mlfqQuanta(quantum, 3), 0, switch_cost));
+    if (name == "priority") return std::unique_ptr<SchedulingPolicy>(new PriorityPolicy(false, quantum, switch_cost));
+    if (name == "ppriority") return std::unique_ptr<SchedulingPolicy>(new PriorityPolicy(true, quantum, switch_cost));
+    return nullptr;
+}
+
+// The three policies every front-end runs, in display order
+inline std::vector<std::unique_ptr<SchedulingPolicy>> defaultPolicies(int quantum) {
+    std::vector<std::unique_ptr<SchedulingPolicy>> policies;
+    policies.emplace_back(new SjfPolicy());
+    policies.emplace_back(new SrtfPolicy());
+    policies.emplace_back(new RoundRobinPolicy(quantum));
+    return policies;
+}
+
+#endif
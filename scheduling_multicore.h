@@ -0,0 +1,316 @@
+// Multi-core simulation: one trace scheduled across N simulated cores.
+//
+// Arrivals are spread over the cores round-robin in arrival order (their
+// "home" core), and every core schedules its own ready queue with FCFS, SJF,
+// SRTF or RR. Time is cut into epochs: within an epoch the cores do not
+// interact, so each core's event stream can be simulated on a different host
+// thread. At every epoch boundary each idle core steals one waiting job from
+// the core with the longest queue. Because stealing only happens at
+// boundaries, results do not depend on how many host threads are used; a
+// shorter epoch steals sooner at the cost of more synchronization.
+#ifndef SCHEDULING_MULTICORE_H
+#define SCHEDULING_MULTICORE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "scheduling_core.h"
+#include "scheduling_parallel.h"
+
+enum class CorePolicy { FCFS, SJF, SRTF, RR };
+
+// Policy by short name ("fcfs", "sjf", "srtf" or "rr"); throws if unknown
+inline CorePolicy corePolicyByName(const std::string& name) {
+    if (name == "fcfs") return CorePolicy::FCFS;
+    if (name == "sjf") return CorePolicy::SJF;
+    if (name == "srtf") return CorePolicy::SRTF;
+    if (name == "rr") return CorePolicy::RR;
+    throw std::invalid_argument("unknown policy '" + name + "'");
+}
+
+inline std::string corePolicyName(CorePolicy policy, int quantum) {
+    switch (policy) {
+    case CorePolicy::FCFS: return "First Come First Served (FCFS)";
+    case CorePolicy::SJF: return "Shortest Job First (SJF)";
+    case CorePolicy::SRTF: return "Shortest Remaining Time First (SRTF)";
+    default: return "Round Robin (RR) - Quantum: " + std::to_string(quantum);
+    }
+}
+
+struct MulticoreOptions {
+    int cores = 4;
+    CorePolicy policy = CorePolicy::FCFS;
+    int quantum = 1;            // RR time slice
+    int32_t epoch = 0;          // Steal interval; 0 picks half the median burst
+    unsigned threads = 0;       // Host threads; 0 = one per hardware thread for
+                                // traces of 100k+ jobs, otherwise one
+};
+
+struct MulticoreResult {
+    ScheduleResult schedule;            // CT/TAT/WT per row; switches summed over cores
+    std::vector<int64_t> busy_time;     // Time each core spent running jobs
+    std::vector<int64_t> completed;     // Jobs each core finished
+    std::vector<int64_t> stolen;        // Jobs each core stole from another
+    int32_t first_arrival = 0;
+    int32_t last_completion = 0;
+
+    // Share of [first arrival, last completion] a core spent running jobs
+    double utilization(int core) const {
+        int64_t span = int64_t(last_completion) - first_arrival;
+        return span > 0 ? double(busy_time[core]) / span : 0;
+    }
+
+    // Busiest core's load over the mean load (1.0 = perfectly balanced)
+    double imbalance() const {
+        int64_t total = 0, busiest = 0;
+        for (int64_t busy : busy_time) {
+            total += busy;
+            busiest = std::max(busiest, busy);
+        }
+        return total > 0 ? double(busiest) * busy_time.size() / total : 1.0;
+    }
+};
+
+// One simulated core: its arrivals, ready queue and the job it is running
+class SimulatedCore {
+public:
+    // Ready or running job
+    struct Job {
+        int32_t row;
+        int32_t remaining;
+    };
+
+    SimulatedCore(const ProcessView& table, const MulticoreOptions& options, ScheduleResult& result)
+        : table(&table), options(&options), result(&result) {}
+
+    std::vector<int32_t> arrivals;      // Home rows in arrival order
+    int64_t busy = 0;
+    int64_t completed = 0;
+    int64_t stolen = 0;
+    int64_t switches = 0;
+
+    bool idle() const { return !has_running && ready.empty(); }
+    size_t waiting() const { return ready.size(); }
+    bool finished() const { return idle() && next_arrival == arrivals.size(); }
+    // Earliest pending arrival, or INT32_MAX if none
+    int32_t nextArrival() const {
+        return next_arrival < arrivals.size() ? table->arrival_time[arrivals[next_arrival]] : INT32_MAX;
+    }
+
+    // Simulate this core's events up to (but not past) horizon
+    void advance(int32_t horizon) {
+        int32_t t = now;
+        for (;;) {
+            admit(t);
+            if (!has_running) {
+                if (ready.empty()) {
+                    // Idle: sleep until the next home arrival or the horizon
+                    t = std::min(nextArrival(), horizon);
+                    if (t >= horizon) break;
+                    continue;
+                }
+                start(pop());
+            }
+
+            // Run until completion, slice end, the next arrival (SRTF may
+            // preempt there) or the horizon, whichever comes first
+            int64_t until = int64_t(t) + running.remaining;
+            if (options->policy == CorePolicy::RR) until = std::min<int64_t>(until, t + slice_left);
+            if (options->policy == CorePolicy::SRTF) until = std::min<int64_t>(until, nextArrival());
+            until = std::min<int64_t>(until, horizon);
+            int32_t ran = until - t;
+            running.remaining -= ran;
+            slice_left -= ran;
+            busy += ran;
+            t = until;
+
+            if (running.remaining == 0) {
+                result->complete(*table, running.row, t);
+                completed++;
+                has_running = false;
+            } else if (options->policy == CorePolicy::RR && slice_left == 0) {
+                // New arrivals queue ahead of the preempted job
+                admit(t);
+                push(running);
+                batch_start = ready.size();
+                has_running = false;
+            } else if (options->policy == CorePolicy::SRTF && nextArrival() == t) {
+                admit(t);
+                if (before(ready.front(), running)) {
+                    push(running);
+                    has_running = false;
+                }
+            }
+            if (t >= horizon) break;
+        }
+        now = t;
+    }
+
+    // Give one waiting job to an idle core: FIFO queues give up their newest
+    // job (the one that would wait longest here), heaps their best one
+    Job giveAway() {
+        if (isHeap()) return pop();
+        Job job = ready.back();
+        ready.pop_back();
+        return job;
+    }
+
+    void receive(const Job& job) {
+        push(job);
+        batch_start = ready.size();
+        stolen++;
+    }
+
+private:
+    const ProcessView* table;
+    const MulticoreOptions* options;
+    ScheduleResult* result;
+    std::deque<Job> ready;              // FIFO for FCFS/RR, binary heap for SJF/SRTF
+    size_t next_arrival = 0;
+    int32_t now = 0;
+    Job running = {-1, 0};
+    bool has_running = false;
+    int32_t slice_left = 0;
+    int32_t last_row = -1;
+    size_t batch_start = 0;             // RR: first job queued since the last dispatch
+
+    bool isHeap() const { return options->policy == CorePolicy::SJF || options->policy == CorePolicy::SRTF; }
+
+    // True if a should run before b
+    bool before(const Job& a, const Job& b) const {
+        if (options->policy == CorePolicy::SRTF) {
+            return a.remaining != b.remaining ? a.remaining < b.remaining : a.row < b.row;
+        }
+        // SJF: (burst, arrival, pid, row) like the single-core engine
+        const int32_t* bt = table->burst_time;
+        const int32_t* at = table->arrival_time;
+        if (bt[a.row] != bt[b.row]) return bt[a.row] < bt[b.row];
+        if (at[a.row] != at[b.row]) return at[a.row] < at[b.row];
+        if (table->pid[a.row] != table->pid[b.row]) return table->pid[a.row] < table->pid[b.row];
+        return a.row < b.row;
+    }
+
+    void push(const Job& job) {
+        ready.push_back(job);
+        if (isHeap()) std::push_heap(ready.begin(), ready.end(), [this](const Job& a, const Job& b) { return before(b, a); });
+    }
+
+    Job pop() {
+        if (isHeap()) std::pop_heap(ready.begin(), ready.end(), [this](const Job& a, const Job& b) { return before(b, a); });
+        Job job = isHeap() ? ready.back() : ready.front();
+        if (isHeap()) ready.pop_back();
+        else ready.pop_front();
+        return job;
+    }
+
+    // RR queues the arrivals since the last dispatch in row order, like the
+    // single-core engine, even when an epoch boundary splits them in two
+    void admit(int32_t t) {
+        while (next_arrival < arrivals.size() && table->arrival_time[arrivals[next_arrival]] <= t) {
+            int32_t row = arrivals[next_arrival++];
+            push({row, table->burst_time[row]});
+        }
+        if (options->policy == CorePolicy::RR) {
+            std::sort(ready.begin() + std::min(batch_start, ready.size()), ready.end(),
+                      [](const Job& a, const Job& b) { return a.row < b.row; });
+        }
+    }
+
+    void start(const Job& job) {
+        running = job;
+        has_running = true;
+        batch_start = ready.size();
+        slice_left = options->quantum;
+        if (last_row >= 0 && last_row != job.row) switches++;
+        last_row = job.row;
+    }
+};
+
+// Schedule table across options.cores simulated cores with work stealing
+inline MulticoreResult simulateMulticore(const ProcessView& table, MulticoreOptions options) {
+    if (options.cores < 1) throw std::invalid_argument("need at least one core");
+    if (options.quantum < 1) options.quantum = 1;
+    int n = table.size();
+    MulticoreResult out;
+    out.schedule = ScheduleResult(n);
+    if (n == 0) return out;
+
+    if (options.epoch <= 0) {
+        std::vector<int32_t> bursts(table.burst_time, table.burst_time + n);
+        std::nth_element(bursts.begin(), bursts.begin() + n / 2, bursts.end());
+        options.epoch = std::max<int32_t>(1, bursts[n / 2] / 2);
+    }
+    if (options.threads == 0) options.threads = n >= 100000 ? ThreadPool::defaultThreads() : 1;
+    options.threads = std::min<unsigned>(options.threads, options.cores);
+
+    // Spread arrivals over home cores round-robin in arrival order
+    std::vector<SimulatedCore> cores(options.cores, SimulatedCore(table, options, out.schedule));
+    std::vector<int32_t> order = arrivalOrder(table);
+    for (int i = 0; i < n; i++) cores[i % options.cores].arrivals.push_back(order[i]);
+
+    std::unique_ptr<ThreadPool> pool;
+    if (options.threads > 1) pool.reset(new ThreadPool(options.threads));
+
+    int64_t epoch_start = table.arrival_time[order[0]];
+    for (int64_t epoch_number = 0;; epoch_number++) {
+        int32_t horizon = std::min<int64_t>(epoch_start + options.epoch, INT32_MAX);
+
+        // Simulate the epoch; cores only touch their own state and rows
+        if (pool) {
+            std::vector<std::future<void>> pending;
+            for (unsigned w = 0; w < options.threads; w++) {
+                pending.push_back(pool->submit([&cores, &options, w, horizon] {
+                    for (size_t c = w; c < cores.size(); c += options.threads) cores[c].advance(horizon);
+                }));
+            }
+            for (auto& f : pending) f.get();
+        } else {
+            for (auto& core : cores) core.advance(horizon);
+        }
+
+        // Idle cores steal one waiting job each from the longest queue; the
+        // first thief rotates every epoch so no core is favoured
+        for (int k = 0; k < options.cores; k++) {
+            SimulatedCore& thief = cores[(epoch_number + k) % options.cores];
+            if (!thief.idle()) continue;
+            SimulatedCore* victim = nullptr;
+            for (auto& core : cores) {
+                if (core.waiting() > 0 && (!victim || core.waiting() > victim->waiting())) victim = &core;
+            }
+            if (!victim) break;
+            thief.receive(victim->giveAway());
+        }
+
+        // Stop when everything is done; skip epochs where every core is idle
+        bool all_idle = true, all_finished = true;
+        int32_t next_arrival = INT32_MAX;
+        for (const auto& core : cores) {
+            all_idle = all_idle && core.idle();
+            all_finished = all_finished && core.finished();
+            next_arrival = std::min(next_arrival, core.nextArrival());
+        }
+        if (all_finished) break;
+        epoch_start = horizon;
+        if (all_idle && next_arrival > horizon) {
+            epoch_start += (int64_t(next_arrival) - horizon) / options.epoch * options.epoch;
+        }
+    }
+
+    out.first_arrival = table.arrival_time[order[0]];
+    out.last_completion = *std::max_element(out.schedule.completion_time.begin(), out.schedule.completion_time.end());
+    for (const auto& core : cores) {
+        out.busy_time.push_back(core.busy);
+        out.completed.push_back(core.completed);
+        out.stolen.push_back(core.stolen);
+        out.schedule.context_switches += core.switches;
+    }
+    return out;
+}
+
+#endif
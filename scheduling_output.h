@@ -0,0 +1,284 @@
+// Result output: per-process results as an aligned table, CSV, JSON Lines
+// or a binary columnar dump.
+//
+// Rows are formatted into a large in-memory buffer with std::to_chars and
+// handed to stdio one buffer at a time, so writing millions of rows costs no
+// per-row stream flush or locale-aware formatting. The table format is the
+// layout scheduling.cpp has always printed; the other formats are meant for
+// other programs and write one record per process in trace row order.
+// Fixed-point results (see scheduling_core.h) are written as decimal numbers
+// in the text formats; the binary format only holds whole 32-bit times.
+//
+// Binary dumps are a sequence of sections, one per algorithm: a ResultHeader,
+// the algorithm name (name_length bytes, no terminator), then the pid,
+// arrival, burst, completion, turnaround and waiting columns stored back to
+// back as little-endian int32.
+#ifndef SCHEDULING_OUTPUT_H
+#define SCHEDULING_OUTPUT_H
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "scheduling_core.h"
+
+enum class OutputFormat { Table, Csv, JsonLines, Binary };
+
+// Format by short name ("table", "csv", "jsonl" or "binary"); throws if unknown
+inline OutputFormat outputFormatByName(const std::string& name) {
+    if (name == "table") return OutputFormat::Table;
+    if (name == "csv") return OutputFormat::Csv;
+    if (name == "jsonl") return OutputFormat::JsonLines;
+    if (name == "binary") return OutputFormat::Binary;
+    throw std::invalid_argument("unknown output format '" + name + "'");
+}
+
+// Header of one section of a binary result dump
+struct ResultHeader {
+    char magic[8];              // "SCHDRES\0"
+    uint32_t version;           // RESULT_VERSION
+    uint32_t columns;           // RESULT_COLUMNS
+    uint64_t rows;              // Number of processes
+    uint64_t name_length;       // Bytes of algorithm name after the header
+};
+
+static const char RESULT_MAGIC[8] = {'S', 'C', 'H', 'D', 'R', 'E', 'S', '\0'};
+static const uint32_t RESULT_VERSION = 1;
+static const uint32_t RESULT_COLUMNS = 6;
+
+// Append-only text/byte buffer in front of a stdio stream
+// Flushes only when full, on flush() and on destruction. Nothing else should
+// write to the same stream until the buffer has been flushed.
+class OutputBuffer {
+public:
+    explicit OutputBuffer(FILE* file, size_t capacity = 1 << 20) : file(file), data(capacity) {}
+    ~OutputBuffer() {
+        // Errors cannot be reported from a destructor; call flush() to see them
+        if (used > 0) std::fwrite(data.data(), 1, used, file);
+    }
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    void put(char c) {
+        if (used == data.size()) flush();
+        data[used++] = c;
+    }
+    void put(const char* bytes, size_t count) {
+        if (count > data.size() - used) {
+            flush();
+            if (count > data.size()) {
+                writeOut(bytes, count);
+                return;
+            }
+        }
+        std::memcpy(data.data() + used, bytes, count);
+        used += count;
+    }
+    void put(const std::string& text) { put(text.data(), text.size()); }
+    // count copies of c
+    void fill(char c, size_t count) {
+        for (size_t i = 0; i < count; i++) put(c);
+    }
+
+    void putInt(int64_t value) {
+        reserve(24);
+        used = std::to_chars(data.data() + used, data.data() + data.size(), value).ptr - data.data();
+    }
+    // Fixed-point with the given number of decimals, like "fixed << setprecision"
+    void putFixed(double value, int decimals) {
+        reserve(350);
+        used = std::to_chars(data.data() + used, data.data() + data.size(), value, std::chars_format::fixed,
+                             decimals).ptr - data.data();
+    }
+    // Left-aligned in a field of width characters, like "left << setw(width)"
+    void putPadded(int64_t value, size_t width) {
+        // Room for the whole field up front, so no flush moves its start
+        reserve(width + 24);
+        size_t start = used;
+        putInt(value);
+        if (used - start < width) fill(' ', width - (used - start));
+    }
+    void putPadded(const std::string& text, size_t width) {
+        put(text);
+        if (text.size() < width) fill(' ', width - text.size());
+    }
+
+    // Write out everything buffered; throws if the stream fails
+    void flush() {
+        writeOut(data.data(), used);
+        used = 0;
+        if (std::fflush(file) != 0) throw std::runtime_error("cannot write results");
+    }
+
+private:
+    FILE* file;
+    std::vector<char> data;
+    size_t used = 0;
+
+    // Make room for count more bytes
+    void reserve(size_t count) {
+        if (data.size() - used < count) flush();
+    }
+    void writeOut(const char* bytes, size_t count) {
+        if (count > 0 && std::fwrite(bytes, 1, count, file) != count) throw std::runtime_error("cannot write results");
+    }
+};
+
+// Writes the results of one or more algorithm runs in one format
+// decimals is the fixed-point resolution of the times (0 for whole units)
+class ResultWriter {
+public:
+    ResultWriter(OutputBuffer& out, OutputFormat format, int decimals = 0)
+        : out(out), format(format), decimals(decimals) {}
+
+    template <typename Time>
+    void write(const BasicProcessView<Time>& table, const BasicScheduleResult<Time>& result,
+               const std::string& algorithm) {
+        switch (format) {
+        case OutputFormat::Table: writeTable(table, result, algorithm); break;
+        case OutputFormat::Csv: writeCsv(table, result, algorithm); break;
+        case OutputFormat::JsonLines: writeJsonLines(table, result, algorithm); break;
+        case OutputFormat::Binary: writeBinary(table, result, algorithm); break;
+        }
+    }
+
+private:
+    OutputBuffer& out;
+    OutputFormat format;
+    int decimals;
+    bool csv_header = false;
+
+    // A time value, as an integer or with the configured decimals
+    void putTime(int64_t ticks) {
+        if (decimals == 0) out.putInt(ticks);
+        else out.put(formatTicks(ticks, decimals));
+    }
+    void putTime(int64_t ticks, size_t width) {
+        if (decimals == 0) out.putPadded(ticks, width);
+        else out.putPadded(formatTicks(ticks, decimals), width);
+    }
+
+    // Separator lines, header, one row per process in PID order and the
+    // averages, exactly as displayTable() printed them with iostreams
+    template <typename Time>
+    void writeTable(const BasicProcessView<Time>& table, const BasicScheduleResult<Time>& result,
+                    const std::string& algorithm) {
+        out.put('\n');
+        out.fill('=', 80);
+        out.put("\nAlgorithm: " + algorithm + "\n");
+        out.fill('=', 80);
+        out.put('\n');
+        out.putPadded("PID", 8);
+        out.putPadded("AT", 8);
+        out.putPadded("BT", 8);
+        out.putPadded("CT", 12);
+        out.putPadded("TAT", 8);
+        out.putPadded("WT", 8);
+        out.put('\n');
+        out.fill('-', 80);
+        out.put('\n');
+
+        double total_wt = 0, total_tt = 0;
+        for (int32_t i : pidOrder<Time>(table)) {
+            out.putPadded(table.pid[i], 8);
+            putTime(table.arrival_time[i], 8);
+            putTime(table.burst_time[i], 8);
+            putTime(result.completion_time[i], 12);
+            putTime(result.turnaround_time[i], 8);
+            putTime(result.waiting_time[i], 8);
+            out.put('\n');
+            total_wt += result.waiting_time[i];
+            total_tt += result.turnaround_time[i];
+        }
+
+        // Averages keep two more decimals than the times themselves
+        double unit = ticksPerUnit(decimals);
+        out.fill('-', 80);
+        out.put("\nAverage WT: ");
+        out.putFixed(total_wt / table.size() / unit, decimals + 2);
+        out.put("\nAverage TT: ");
+        out.putFixed(total_tt / table.size() / unit, decimals + 2);
+        out.put('\n');
+    }
+
+    // algorithm,pid,arrival,burst,completion,turnaround,waiting
+    template <typename Time>
+    void writeCsv(const BasicProcessView<Time>& table, const BasicScheduleResult<Time>& result,
+                  const std::string& algorithm) {
+        if (!csv_header) {
+            out.put("algorithm,pid,arrival,burst,completion,turnaround,waiting\n");
+            csv_header = true;
+        }
+        // Names contain commas, so they are always quoted
+        std::string quoted = "\"";
+        for (char c : algorithm) quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+        quoted += "\",";
+        const Time* times[RESULT_COLUMNS - 1] = {table.arrival_time, table.burst_time, result.completion_time.data(),
+                                                 result.turnaround_time.data(), result.waiting_time.data()};
+        for (size_t i = 0; i < table.size(); i++) {
+            out.put(quoted);
+            out.putInt(table.pid[i]);
+            for (uint32_t c = 0; c + 1 < RESULT_COLUMNS; c++) {
+                out.put(',');
+                putTime(times[c][i]);
+            }
+            out.put('\n');
+        }
+    }
+
+    // {"algorithm":"...","pid":1,"arrival":0,...} per process
+    template <typename Time>
+    void writeJsonLines(const BasicProcessView<Time>& table, const BasicScheduleResult<Time>& result,
+                        const std::string& algorithm) {
+        std::string prefix = "{\"algorithm\":\"";
+        for (char c : algorithm) {
+            if (c == '"' || c == '\\') prefix += '\\';
+            prefix += c;
+        }
+        prefix += "\",\"pid\":";
+        for (size_t i = 0; i < table.size(); i++) {
+            out.put(prefix);
+            out.putInt(table.pid[i]);
+            out.put(",\"arrival\":");
+            putTime(table.arrival_time[i]);
+            out.put(",\"burst\":");
+            putTime(table.burst_time[i]);
+            out.put(",\"completion\":");
+            putTime(result.completion_time[i]);
+            out.put(",\"turnaround\":");
+            putTime(result.turnaround_time[i]);
+            out.put(",\"waiting\":");
+            putTime(result.waiting_time[i]);
+            out.put("}\n");
+        }
+    }
+
+    template <typename Time>
+    void writeBinary(const BasicProcessView<Time>& table, const BasicScheduleResult<Time>& result,
+                     const std::string& algorithm) {
+        if (!std::is_same<Time, int32_t>::value || decimals != 0) {
+            throw std::invalid_argument("binary results only hold whole 32-bit times");
+        }
+        ResultHeader header = {};
+        std::memcpy(header.magic, RESULT_MAGIC, sizeof header.magic);
+        header.version = RESULT_VERSION;
+        header.columns = RESULT_COLUMNS;
+        header.rows = table.size();
+        header.name_length = algorithm.size();
+        out.put(reinterpret_cast<const char*>(&header), sizeof header);
+        out.put(algorithm);
+        const void* columns[RESULT_COLUMNS] = {table.pid, table.arrival_time, table.burst_time,
+                                               result.completion_time.data(), result.turnaround_time.data(),
+                                               result.waiting_time.data()};
+        for (uint32_t c = 0; c < RESULT_COLUMNS; c++) {
+            out.put(static_cast<const char*>(columns[c]), table.size() * sizeof(int32_t));
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,374 @@
+// Thread pool and parallel runners for the scheduling core.
+//
+// Every engine reads its input through a const ProcessView and writes only its
+// own ScheduleResult, so independent runs over one trace can share the input
+// without copies or locks.
+#ifndef SCHEDULING_PARALLEL_H
+#define SCHEDULING_PARALLEL_H
+
+#include <algorithm>
+#include <climits>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "scheduling_core.h"
+
+// Fixed-size pool of worker threads fed from a FIFO task queue
+class ThreadPool {
+public:
+    // threads == 0 uses one worker per hardware thread
+    explicit ThreadPool(unsigned threads = 0) {
+        if (threads == 0) threads = defaultThreads();
+        for (unsigned i = 0; i < threads; i++) {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return workers.size(); }
+
+    // Queue a task; the future carries its return value or exception
+    template <typename F>
+    auto submit(F task) -> std::future<decltype(task())> {
+        typedef decltype(task()) R;
+        auto packaged = std::make_shared<std::packaged_task<R()>>(std::move(task));
+        std::future<R> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push([packaged] { (*packaged)(); });
+        }
+        wake.notify_one();
+        return result;
+    }
+
+    static unsigned defaultThreads() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n > 0 ? n : 1;
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    void work() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+};
+
+// Radix sort of packed (key, row) entries (see radixSort()) over chunks of the
+// input: for every digit, each chunk counts its digits, a serial pass over
+// (digit, chunk) turns the counts into each chunk's first slot per digit, and
+// the chunks scatter concurrently. Chunks scatter in input order within every
+// digit, so the passes stay stable and the result equals radixSort()'s.
+inline void parallelRadixSort(ThreadPool& pool, std::vector<uint64_t>& entries, uint32_t max_key,
+                              size_t min_chunk = 1 << 16) {
+    size_t n = entries.size();
+    size_t chunks = std::min<size_t>(4 * pool.size(), n / min_chunk);
+    if (chunks < 2) {
+        radixSort(entries, max_key);
+        return;
+    }
+    std::vector<size_t> bounds(chunks + 1);
+    for (size_t c = 0; c <= chunks; c++) bounds[c] = n * c / chunks;
+
+    std::vector<uint64_t> scratch(n);
+    // start[c * RADIX_BUCKETS + d]: count, then first slot, of digit d in chunk c
+    std::vector<size_t> start(chunks * RADIX_BUCKETS);
+    std::vector<std::future<void>> pending;
+    for (int pass = 0; pass < radixPasses(max_key); pass++) {
+        int shift = radixShift(pass);
+        const uint64_t* from = entries.data();
+        uint64_t* to = scratch.data();
+        std::fill(start.begin(), start.end(), 0);
+        pending.clear();
+        for (size_t c = 0; c < chunks; c++) {
+            pending.push_back(pool.submit([&, c] {
+                size_t* count = start.data() + c * RADIX_BUCKETS;
+                for (size_t i = bounds[c]; i < bounds[c + 1]; i++) count[radixDigit(from[i], shift)]++;
+            }));
+        }
+        for (auto& f : pending) f.get();
+
+        size_t position = 0;
+        for (size_t d = 0; d < RADIX_BUCKETS; d++) {
+            for (size_t c = 0; c < chunks; c++) {
+                size_t& s = start[c * RADIX_BUCKETS + d];
+                size_t count = s;
+                s = position;
+                position += count;
+            }
+        }
+
+        pending.clear();
+        for (size_t c = 0; c < chunks; c++) {
+            pending.push_back(pool.submit([&, c] {
+                size_t* slot = start.data() + c * RADIX_BUCKETS;
+                for (size_t i = bounds[c]; i < bounds[c + 1]; i++) to[slot[radixDigit(from[i], shift)]++] = from[i];
+            }));
+        }
+        for (auto& f : pending) f.get();
+        entries.swap(scratch);
+    }
+}
+
+// arrivalOrder() with the radix sort spread over the pool
+inline std::vector<int32_t> parallelArrivalOrder(ThreadPool& pool, const ProcessView& table,
+                                                 size_t min_chunk = 1 << 16) {
+    if (arrivalSorted(table)) return arrivalOrder(table);
+    uint32_t max_key;
+    std::vector<uint64_t> entries = radixEntries(table.arrival_time, table.size(), max_key);
+    parallelRadixSort(pool, entries, max_key, min_chunk);
+    return radixRows(entries);
+}
+
+// FCFS as a two-pass parallel scan over chunks of a trace in arrival order
+// Pass 1 scans every chunk from an empty carry, which only yields the chunk's
+// burst sum and best (at - S) relative to its own start. A serial pass over
+// the chunks turns those into each chunk's incoming carry, and pass 2 rescans
+// every chunk from its carry, writing CT/TAT/WT. An unsorted trace is put in
+// arrival order by parallelArrivalOrder() and gathered chunk by chunk first.
+// Same result as fcfs(); falls back to it for small traces and when sums might
+// overflow, where fcfs() throws std::overflow_error if a completion does not
+// fit in 32 bits.
+inline ScheduleResult parallelFcfs(ThreadPool& pool, const ProcessView& table, int switch_cost = 0,
+                                   size_t min_chunk = 1 << 16) {
+    size_t n = table.size();
+    size_t chunks = std::min<size_t>(4 * pool.size(), n / min_chunk);
+    if (chunks < 2 || !fcfsScanFits(table, switch_cost)) return fcfs(table, nullptr, switch_cost);
+
+    ScheduleResult result(n);
+    const int32_t* at = table.arrival_time;
+    const int32_t* bt = table.burst_time;
+    int32_t* ct = result.completion_time.data();
+    std::vector<std::future<void>> pending;
+    bool sorted = arrivalSorted(table);
+    std::vector<int32_t> order, sorted_at, sorted_bt, sorted_ct;
+    if (!sorted) {
+        order = parallelArrivalOrder(pool, table, min_chunk);
+        sorted_at.resize(n);
+        sorted_bt.resize(n);
+        sorted_ct.resize(n);
+        for (size_t c = 0; c < chunks; c++) {
+            pending.push_back(pool.submit([&, c] {
+                for (size_t i = n * c / chunks; i < n * (c + 1) / chunks; i++) {
+                    sorted_at[i] = table.arrival_time[order[i]];
+                    sorted_bt[i] = table.burst_time[order[i]];
+                }
+            }));
+        }
+        for (auto& f : pending) f.get();
+        at = sorted_at.data();
+        bt = sorted_bt.data();
+        ct = sorted_ct.data();
+    }
+    // Row 0 is never charged a switch, so the chunks cover rows 1..n-1
+    std::vector<size_t> bounds(chunks + 1);
+    for (size_t c = 0; c <= chunks; c++) bounds[c] = 1 + (n - 1) * c / chunks;
+
+    std::vector<FcfsCarry> local(chunks);
+    pending.clear();
+    for (size_t c = 0; c < chunks; c++) {
+        pending.push_back(pool.submit([&, c] {
+            fcfsScan(at + bounds[c], bt + bounds[c], bounds[c + 1] - bounds[c], switch_cost, nullptr, local[c]);
+        }));
+    }
+    for (auto& f : pending) f.get();
+
+    // Incoming carry of each chunk: S adds up, and a chunk's local best
+    // shifts down by the S that precedes it
+    std::vector<FcfsCarry> incoming(chunks);
+    incoming[0].sum = bt[0];
+    incoming[0].best = at[0];
+    ct[0] = at[0] + bt[0];
+    for (size_t c = 1; c < chunks; c++) {
+        const FcfsCarry& before = incoming[c - 1];
+        incoming[c].sum = before.sum + local[c - 1].sum;
+        incoming[c].best = std::max<int64_t>(before.best, int64_t(local[c - 1].best) - before.sum);
+    }
+
+    pending.clear();
+    for (size_t c = 0; c < chunks; c++) {
+        pending.push_back(pool.submit([&, c] {
+            FcfsCarry carry = incoming[c];
+            fcfsScan(at + bounds[c], bt + bounds[c], bounds[c + 1] - bounds[c], switch_cost, ct + bounds[c], carry);
+            if (sorted) {
+                fcfsFinish(table, result, c == 0 ? 0 : bounds[c], bounds[c + 1], switch_cost);
+                return;
+            }
+            // Scatter CT back to trace rows and fill their TAT/WT
+            for (size_t i = c == 0 ? 0 : bounds[c]; i < bounds[c + 1]; i++) {
+                int32_t row = order[i];
+                result.completion_time[row] = ct[i];
+                result.turnaround_time[row] = ct[i] - at[i];
+                result.waiting_time[row] = result.turnaround_time[row] - bt[i];
+            }
+        }));
+    }
+    for (auto& f : pending) f.get();
+    // The per-row work is done; this only sets the switch counts
+    if (!sorted) fcfsFinish(table, result, 0, 0, switch_cost);
+    return result;
+}
+
+// Run every policy on the same input concurrently
+// Results come back in the order of policies, whatever order they finish in,
+// so wall-clock time is close to the slowest single policy. If gantts is not
+// null it is resized to one chart per policy and each run records into its own.
+// If sinks is not null it holds one sink per policy, and the runs stream their
+// completions there instead of filling result columns.
+// FCFS with neither a chart nor a sink runs as parallelFcfs() on the calling
+// thread once the other policies are queued, since its chunks need free
+// workers; parallelFcfs() itself falls back to fcfs() for small traces.
+inline std::vector<ScheduleResult> runPolicies(ThreadPool& pool, const ProcessView& table,
+                                               const std::vector<std::unique_ptr<SchedulingPolicy>>& policies,
+                                               std::vector<GanttChart>* gantts = nullptr,
+                                               const std::vector<CompletionSink*>* sinks = nullptr) {
+    if (gantts) gantts->assign(policies.size(), GanttChart());
+    std::vector<std::future<ScheduleResult>> pending(policies.size());
+    std::vector<size_t> scans;
+    for (size_t i = 0; i < policies.size(); i++) {
+        const SchedulingPolicy* p = policies[i].get();
+        GanttChart* gantt = gantts ? &(*gantts)[i] : nullptr;
+        CompletionSink* sink = sinks ? (*sinks)[i] : nullptr;
+        if (!gantt && !sink && pool.size() > 1 && dynamic_cast<const FcfsPolicy*>(p)) {
+            scans.push_back(i);
+            continue;
+        }
+        pending[i] = pool.submit([p, &table, gantt, sink] { return p->schedule(table, gantt, sink); });
+    }
+    std::vector<ScheduleResult> results(policies.size());
+    std::exception_ptr error;
+    for (size_t i : scans) {
+        int switch_cost = static_cast<const FcfsPolicy*>(policies[i].get())->switchCost();
+        try {
+            results[i] = parallelFcfs(pool, table, switch_cost);
+        } catch (...) {
+            error = std::current_exception();
+        }
+    }
+    // Runs write into the caller's charts and sinks, so all of them finish
+    // before an error (e.g. FCFS times past 32 bits) reaches the caller
+    for (auto& f : pending) {
+        if (f.valid()) f.wait();
+    }
+    if (error) std::rethrow_exception(error);
+    for (size_t i = 0; i < policies.size(); i++) {
+        if (pending[i].valid()) results[i] = pending[i].get();
+    }
+    return results;
+}
+
+// One point of a Round Robin quantum sweep
+struct QuantumPoint {
+    int quantum;
+    double average_waiting;
+    double average_turnaround;
+    int64_t context_switches;
+    double cpu_utilization;     // Useful work over the busy span, after switch overhead
+    bool pareto = false;        // No other quantum is at least as good on all three metrics
+};
+
+// Mark the points that are Pareto-optimal over (avg WT, avg TAT, switches)
+inline void markPareto(std::vector<QuantumPoint>& points) {
+    for (auto& p : points) {
+        p.pareto = true;
+        for (const auto& q : points) {
+            bool no_worse = q.average_waiting <= p.average_waiting && q.average_turnaround <= p.average_turnaround &&
+                            q.context_switches <= p.context_switches;
+            bool better = q.average_waiting < p.average_waiting || q.average_turnaround < p.average_turnaround ||
+                          q.context_switches < p.context_switches;
+            if (no_worse && better) {
+                p.pareto = false;
+                break;
+            }
+        }
+    }
+}
+
+// The sums a quantum sweep reports, collected as jobs complete so that a
+// sweep point allocates no CT/TAT/WT columns
+class RunTotals : public CompletionSink {
+public:
+    int64_t jobs = 0;
+    int64_t waiting = 0;
+    int64_t turnaround = 0;
+    int64_t busy = 0;
+    int32_t first_arrival = INT32_MAX;
+    int32_t last_completion = INT32_MIN;
+
+    void started(const ProcessView&, int32_t, int64_t) override {}
+
+    void completed(const ProcessView& table, int32_t row, int32_t ct) override {
+        jobs++;
+        turnaround += int64_t(ct) - table.arrival_time[row];
+        waiting += int64_t(ct) - table.arrival_time[row] - table.burst_time[row];
+        busy += table.burst_time[row];
+        first_arrival = std::min(first_arrival, table.arrival_time[row]);
+        last_completion = std::max(last_completion, ct);
+    }
+
+    double averageWaiting() const { return jobs ? double(waiting) / jobs : 0; }
+    double averageTurnaround() const { return jobs ? double(turnaround) / jobs : 0; }
+    // Same as ScheduleResult::cpuUtilization()
+    double cpuUtilization() const {
+        if (jobs == 0) return 0;
+        return last_completion > first_arrival ? double(busy) / (last_completion - first_arrival) : 1.0;
+    }
+};
+
+// Simulate Round Robin for every quantum in [first, last] stepping by step,
+// one quantum per pool task, and return the curve in quantum order with the
+// Pareto-optimal points marked. switch_cost is charged on every switch, so
+// tiny quanta pay for the dispatches they cause. step must be positive.
+inline std::vector<QuantumPoint> sweepQuantum(ThreadPool& pool, const ProcessView& table,
+                                              int first, int last, int step = 1, int switch_cost = 0) {
+    std::vector<std::future<QuantumPoint>> pending;
+    // Count the points first, so a range ending near INT_MAX cannot overflow q
+    int64_t points_in_range = last < first ? 0 : (int64_t(last) - first) / step + 1;
+    for (int64_t i = 0; i < points_in_range; i++) {
+        int q = int(first + i * step);
+        pending.push_back(pool.submit([q, &table, switch_cost] {
+            RunTotals totals;
+            ScheduleResult result = roundRobin(table, q, nullptr, switch_cost, &totals);
+            return QuantumPoint{q, totals.averageWaiting(), totals.averageTurnaround(), result.context_switches,
+                                totals.cpuUtilization()};
+        }));
+    }
+    std::vector<QuantumPoint> points;
+    for (auto& f : pending) points.push_back(f.get());
+    markPareto(points);
+    return points;
+}
+
+#endif
@@ -0,0 +1,156 @@
+// Streaming statistics: percentiles without keeping per-job results.
+//
+// A run with a CompletionSink never allocates its CT/TAT/WT columns; every
+// first dispatch and completion is folded into the sink as it happens.
+// StreamingStats keeps a QuantileSketch each for waiting, turnaround and
+// response time, so its memory depends on the value range and the requested
+// error, not on the number of jobs. The sketch is a log-linear histogram
+// (HDR histogram layout) rather than a t-digest: the times are integers,
+// the error bound holds for every quantile, and merging two sketches is
+// exact, so per-thread sketches combine to the same result in any order.
+#ifndef SCHEDULING_SKETCH_H
+#define SCHEDULING_SKETCH_H
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "scheduling_core.h"
+
+// Log-linear histogram of non-negative integers
+// Values below 2 * S are counted exactly; above that, every power-of-two
+// range is split into S buckets, S being the smallest power of two with
+// 1 / (2 * S) <= relative_error. A quantile is reported as the middle of
+// its bucket, so it is within relative_error of the exact nearest-rank value.
+class QuantileSketch {
+public:
+    explicit QuantileSketch(double relative_error = 0.01) {
+        if (!(relative_error > 0 && relative_error < 1)) {
+            throw std::invalid_argument("sketch error must be between 0 and 1");
+        }
+        while (sub_bits < 30 && 1.0 / (int64_t(2) << sub_bits) > relative_error) sub_bits++;
+    }
+
+    // Count one value; negative values count as 0
+    void add(int64_t value) {
+        value = std::max<int64_t>(value, 0);
+        size_t index = bucketOf(value);
+        if (index >= counts.size()) counts.resize(index + 1);
+        counts[index]++;
+        total++;
+        sum += value;
+        low = std::min(low, value);
+        high = std::max(high, value);
+    }
+
+    // Fold in another sketch with the same error
+    void merge(const QuantileSketch& other) {
+        if (other.sub_bits != sub_bits) throw std::invalid_argument("cannot merge sketches of different error");
+        if (other.counts.size() > counts.size()) counts.resize(other.counts.size());
+        for (size_t i = 0; i < other.counts.size(); i++) counts[i] += other.counts[i];
+        total += other.total;
+        sum += other.sum;
+        low = std::min(low, other.low);
+        high = std::max(high, other.high);
+    }
+
+    uint64_t count() const { return total; }
+    int64_t min() const { return total ? low : 0; }
+    int64_t max() const { return total ? high : 0; }
+    double mean() const { return total ? double(sum) / total : 0; }
+    // Largest relative error of a quantile
+    double relativeError() const { return 1.0 / (int64_t(2) << sub_bits); }
+    size_t memoryBytes() const { return counts.capacity() * sizeof(uint64_t); }
+
+    // Nearest-rank percentile p (0-100), within relativeError() of the exact one
+    int64_t quantile(double p) const {
+        if (total == 0) return 0;
+        uint64_t rank = uint64_t(std::ceil(p / 100 * total));
+        rank = std::min(std::max<uint64_t>(rank, 1), total);
+        uint64_t seen = 0;
+        size_t index = 0;
+        while (seen + counts[index] < rank) seen += counts[index++];
+        // The extremes are known exactly
+        if (rank == 1) return low;
+        if (rank == total) return high;
+        int64_t first = lowestOf(index), width = widthOf(index);
+        return std::min(std::max(first + (width - 1) / 2, low), high);
+    }
+
+private:
+    int sub_bits = 0;                   // S = 2^sub_bits buckets per power of two
+    std::vector<uint64_t> counts;       // Grown up to the largest bucket seen
+    uint64_t total = 0;
+    int64_t sum = 0;
+    int64_t low = INT64_MAX;
+    int64_t high = INT64_MIN;
+
+    // Index of a value's bucket: values below 2 * S map to themselves; a
+    // larger value with top bit m keeps its top sub_bits + 1 bits
+    size_t bucketOf(int64_t value) const {
+        if (value < (int64_t(2) << sub_bits)) return value;
+        int shift = 63 - __builtin_clzll(value) - sub_bits;
+        return (size_t(shift) << sub_bits) + (value >> shift);
+    }
+
+    int shiftOf(size_t index) const {
+        return index < (size_t(2) << sub_bits) ? 0 : int(index >> sub_bits) - 1;
+    }
+    int64_t lowestOf(size_t index) const {
+        int shift = shiftOf(index);
+        return int64_t(index - (size_t(shift) << sub_bits)) << shift;
+    }
+    int64_t widthOf(size_t index) const { return int64_t(1) << shiftOf(index); }
+};
+
+// Aggregates of a streaming run: sketches of WT, TAT and response time (first
+// dispatch minus arrival), Jain's index over slowdown and the busy span
+// Memory stays constant however many jobs complete.
+class StreamingStats : public CompletionSink {
+public:
+    explicit StreamingStats(double relative_error = 0.01)
+        : waiting(relative_error), turnaround(relative_error), response(relative_error) {}
+
+    QuantileSketch waiting;
+    QuantileSketch turnaround;
+    QuantileSketch response;
+
+    void started(const ProcessView& table, int32_t row, int64_t t) override {
+        response.add(t - table.arrival_time[row]);
+    }
+
+    void completed(const ProcessView& table, int32_t row, int32_t ct) override {
+        int64_t tat = int64_t(ct) - table.arrival_time[row];
+        turnaround.add(tat);
+        waiting.add(tat - table.burst_time[row]);
+        // Slowdown with bursts of 0 counted as 1, as in scheduleStats()
+        double slowdown = double(tat) / std::max(table.burst_time[row], 1);
+        slowdown_sum += slowdown;
+        slowdown_squares += slowdown * slowdown;
+        busy += table.burst_time[row];
+        first_arrival = std::min<int64_t>(first_arrival, table.arrival_time[row]);
+        last_completion = std::max<int64_t>(last_completion, ct);
+    }
+
+    // Jain's index over per-job slowdown (1.0 = every job slowed down equally)
+    double fairness() const {
+        return slowdown_squares > 0 ? slowdown_sum * slowdown_sum / (waiting.count() * slowdown_squares) : 1;
+    }
+
+    // Share of [first arrival, last completion] spent running processes
+    double cpuUtilization() const {
+        return last_completion > first_arrival ? double(busy) / (last_completion - first_arrival) : 1.0;
+    }
+
+private:
+    double slowdown_sum = 0;
+    double slowdown_squares = 0;
+    int64_t busy = 0;
+    int64_t first_arrival = INT64_MAX;
+    int64_t last_completion = INT64_MIN;
+};
+
+#endif
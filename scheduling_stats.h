@@ -0,0 +1,273 @@
+// Summary statistics over the CT/TAT/WT columns of a schedule.
+//
+// Averages alone hide the tail, so this adds min/max, standard deviation,
+// p50/p95/p99 and Jain's fairness index. Sums, extremes and deviations are
+// reduced several rows at a time (AVX2 when the CPU has it, picked at run
+// time like the FCFS scan). Percentiles come from a histogram select: one
+// pass counts values into 2^16 buckets over [min, max], the buckets holding
+// the wanted ranks are found from the running counts, and only the values in
+// those buckets are gathered and selected exactly, so no copy or sort of the
+// whole column is needed.
+#ifndef SCHEDULING_STATS_H
+#define SCHEDULING_STATS_H
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "scheduling_core.h"
+
+// Buckets of the percentile histogram
+static const int STATS_BUCKET_BITS = 16;
+
+struct ColumnStats {
+    size_t count = 0;
+    int32_t min = 0;
+    int32_t max = 0;
+    double mean = 0;
+    double stddev = 0;          // Population standard deviation
+    int32_t p50 = 0;            // Nearest-rank percentiles
+    int32_t p95 = 0;
+    int32_t p99 = 0;
+};
+
+struct ScheduleStats {
+    ColumnStats waiting;
+    ColumnStats turnaround;
+    // Jain's index over per-job slowdown (TAT / BT, with BT of 0 counted as
+    // 1): 1.0 when every job is slowed down equally, down to 1/n when one job
+    // takes all the delay
+    double fairness = 1;
+};
+
+// Sum, min and max of a column
+struct ColumnTotals {
+    int64_t sum = 0;
+    int32_t min = INT32_MAX;
+    int32_t max = INT32_MIN;
+};
+
+inline ColumnTotals columnTotalsScalar(const int32_t* x, size_t n, ColumnTotals totals = ColumnTotals()) {
+    for (size_t i = 0; i < n; i++) {
+        totals.sum += x[i];
+        totals.min = std::min(totals.min, x[i]);
+        totals.max = std::max(totals.max, x[i]);
+    }
+    return totals;
+}
+
+// Sum of (x - mean)^2, plus the sums of r and r^2 for the ratios
+// r = x / max(y, 1) (y may be null, then only the deviations are summed)
+struct DeviationTotals {
+    double squares = 0;
+    double ratio_sum = 0;
+    double ratio_squares = 0;
+};
+
+inline DeviationTotals deviationTotalsScalar(const int32_t* x, const int32_t* y, size_t n, double mean,
+                                             DeviationTotals totals = DeviationTotals()) {
+    for (size_t i = 0; i < n; i++) {
+        double d = x[i] - mean;
+        totals.squares += d * d;
+        if (y) {
+            double r = double(x[i]) / std::max(y[i], 1);
+            totals.ratio_sum += r;
+            totals.ratio_squares += r * r;
+        }
+    }
+    return totals;
+}
+
+#ifdef SCHEDULING_HAVE_AVX2_DISPATCH
+// Eight rows per step; the sum is kept in two sets of four 64-bit lanes
+__attribute__((target("avx2")))
+inline ColumnTotals columnTotalsAvx2(const int32_t* x, size_t n) {
+    __m256i sum_low = _mm256_setzero_si256(), sum_high = _mm256_setzero_si256();
+    __m256i low = _mm256_set1_epi32(INT32_MAX), high = _mm256_set1_epi32(INT32_MIN);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(x + i));
+        sum_low = _mm256_add_epi64(sum_low, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        sum_high = _mm256_add_epi64(sum_high, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        low = _mm256_min_epi32(low, v);
+        high = _mm256_max_epi32(high, v);
+    }
+    alignas(32) int64_t sums[4];
+    alignas(32) int32_t lows[8], highs[8];
+    _mm256_store_si256((__m256i*)sums, _mm256_add_epi64(sum_low, sum_high));
+    _mm256_store_si256((__m256i*)lows, low);
+    _mm256_store_si256((__m256i*)highs, high);
+    ColumnTotals totals;
+    for (int lane = 0; lane < 4; lane++) totals.sum += sums[lane];
+    for (int lane = 0; lane < 8; lane++) {
+        totals.min = std::min(totals.min, lows[lane]);
+        totals.max = std::max(totals.max, highs[lane]);
+    }
+    return columnTotalsScalar(x + i, n - i, totals);
+}
+
+// Four rows per step in double lanes
+__attribute__((target("avx2")))
+inline DeviationTotals deviationTotalsAvx2(const int32_t* x, const int32_t* y, size_t n, double mean) {
+    const __m256d center = _mm256_set1_pd(mean);
+    __m256d squares = _mm256_setzero_pd(), ratio_sum = _mm256_setzero_pd(), ratio_squares = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(x + i)));
+        __m256d d = _mm256_sub_pd(v, center);
+        squares = _mm256_add_pd(squares, _mm256_mul_pd(d, d));
+        if (y) {
+            __m128i divisor = _mm_max_epi32(_mm_loadu_si128((const __m128i*)(y + i)), _mm_set1_epi32(1));
+            __m256d r = _mm256_div_pd(v, _mm256_cvtepi32_pd(divisor));
+            ratio_sum = _mm256_add_pd(ratio_sum, r);
+            ratio_squares = _mm256_add_pd(ratio_squares, _mm256_mul_pd(r, r));
+        }
+    }
+    alignas(32) double lanes[3][4];
+    _mm256_store_pd(lanes[0], squares);
+    _mm256_store_pd(lanes[1], ratio_sum);
+    _mm256_store_pd(lanes[2], ratio_squares);
+    DeviationTotals totals;
+    for (int lane = 0; lane < 4; lane++) {
+        totals.squares += lanes[0][lane];
+        totals.ratio_sum += lanes[1][lane];
+        totals.ratio_squares += lanes[2][lane];
+    }
+    return deviationTotalsScalar(x + i, y ? y + i : nullptr, n - i, mean, totals);
+}
+#endif
+
+// Reductions with the widest kernel the CPU supports
+inline ColumnTotals columnTotals(const int32_t* x, size_t n) {
+#ifdef SCHEDULING_HAVE_AVX2_DISPATCH
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2) return columnTotalsAvx2(x, n);
+#endif
+    return columnTotalsScalar(x, n);
+}
+
+inline DeviationTotals deviationTotals(const int32_t* x, const int32_t* y, size_t n, double mean) {
+#ifdef SCHEDULING_HAVE_AVX2_DISPATCH
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2) return deviationTotalsAvx2(x, y, n, mean);
+#endif
+    return deviationTotalsScalar(x, y, n, mean);
+}
+
+// Rows per block of the second pass; a block of x and y stays in L1 between
+// the deviation kernel and the histogram loop
+static const size_t STATS_BLOCK = 2048;
+
+// Bucket width (as a shift) that fits [min, max] into the histogram
+inline int bucketShift(int32_t min, int32_t max) {
+    int64_t range = int64_t(max) - min;
+    int shift = 0;
+    while ((range >> shift) >= (int64_t(1) << STATS_BUCKET_BITS)) shift++;
+    return shift;
+}
+
+// Second pass over a column: deviations from the mean (and ratios to y)
+// plus the percentile histogram, so the column is read from memory once more
+inline DeviationTotals histogramPass(const int32_t* x, const int32_t* y, size_t n, double mean, int32_t min,
+                                     int shift, std::vector<uint32_t>& counts) {
+    DeviationTotals totals;
+    for (size_t first = 0; first < n; first += STATS_BLOCK) {
+        size_t rows = std::min(STATS_BLOCK, n - first);
+        DeviationTotals block = deviationTotals(x + first, y ? y + first : nullptr, rows, mean);
+        totals.squares += block.squares;
+        totals.ratio_sum += block.ratio_sum;
+        totals.ratio_squares += block.ratio_squares;
+        for (size_t i = first; i < first + rows; i++) counts[uint32_t(int64_t(x[i]) - min) >> shift]++;
+    }
+    return totals;
+}
+
+// Values of the given 0-based ranks (ascending) from the histogram of a column
+inline std::vector<int32_t> selectRanks(const int32_t* x, size_t n, int32_t min, int shift,
+                                        const std::vector<uint32_t>& counts, const std::vector<size_t>& ranks) {
+    // Bucket of each rank and its rank within the bucket
+    std::vector<uint32_t> bucket(ranks.size());
+    std::vector<size_t> within(ranks.size());
+    size_t below = 0, b = 0;
+    for (size_t k = 0; k < ranks.size(); k++) {
+        while (below + counts[b] <= ranks[k]) below += counts[b++];
+        bucket[k] = b;
+        within[k] = ranks[k] - below;
+    }
+
+    // Unit-width buckets hold a single value each
+    std::vector<int32_t> values(ranks.size());
+    if (shift == 0) {
+        for (size_t k = 0; k < ranks.size(); k++) values[k] = min + int32_t(bucket[k]);
+        return values;
+    }
+    // Otherwise gather the wanted buckets (at most one per rank) and select
+    std::vector<std::vector<int32_t>> members(ranks.size());
+    for (size_t k = 0; k < ranks.size(); k++) members[k].reserve(counts[bucket[k]]);
+    for (size_t i = 0; i < n; i++) {
+        uint32_t own = uint32_t(int64_t(x[i]) - min) >> shift;
+        for (size_t k = 0; k < ranks.size(); k++) {
+            if (own == bucket[k]) {
+                members[k].push_back(x[i]);
+                break;
+            }
+        }
+    }
+    for (size_t k = 0; k < ranks.size(); k++) {
+        // Ranks sharing a bucket share the first one's members
+        size_t first = k;
+        while (first > 0 && bucket[first - 1] == bucket[k]) first--;
+        std::vector<int32_t>& m = members[first];
+        std::nth_element(m.begin(), m.begin() + within[k], m.end());
+        values[k] = m[within[k]];
+    }
+    return values;
+}
+
+// Nearest-rank index of percentile p in n values
+inline size_t percentileRank(size_t n, double p) {
+    size_t rank = size_t(std::ceil(p / 100 * n));
+    return rank > 0 ? rank - 1 : 0;
+}
+
+// All statistics of one column in two passes; if y is given, the sums of the
+// ratios x / max(y, 1) are returned in ratios
+inline ColumnStats columnStats(const int32_t* x, size_t n, const int32_t* y = nullptr,
+                               DeviationTotals* ratios = nullptr) {
+    ColumnStats stats;
+    stats.count = n;
+    if (n == 0) return stats;
+    ColumnTotals totals = columnTotals(x, n);
+    stats.min = totals.min;
+    stats.max = totals.max;
+    stats.mean = double(totals.sum) / n;
+
+    int shift = bucketShift(totals.min, totals.max);
+    std::vector<uint32_t> counts(((int64_t(totals.max) - totals.min) >> shift) + 1);
+    DeviationTotals deviations = histogramPass(x, y, n, stats.mean, totals.min, shift, counts);
+    stats.stddev = std::sqrt(deviations.squares / n);
+    if (ratios) *ratios = deviations;
+
+    std::vector<int32_t> p = selectRanks(x, n, totals.min, shift, counts,
+                                         {percentileRank(n, 50), percentileRank(n, 95), percentileRank(n, 99)});
+    stats.p50 = p[0];
+    stats.p95 = p[1];
+    stats.p99 = p[2];
+    return stats;
+}
+
+// Waiting and turnaround statistics and fairness of a schedule
+inline ScheduleStats scheduleStats(const ProcessView& table, const ScheduleResult& result) {
+    ScheduleStats stats;
+    size_t n = table.size();
+    DeviationTotals slowdown;
+    stats.waiting = columnStats(result.waiting_time.data(), n);
+    stats.turnaround = columnStats(result.turnaround_time.data(), n, table.burst_time, &slowdown);
+    // Jain's index: (sum r)^2 / (n * sum r^2)
+    if (slowdown.ratio_squares > 0) stats.fairness = slowdown.ratio_sum * slowdown.ratio_sum / (n * slowdown.ratio_squares);
+    return stats;
+}
+
+#endif
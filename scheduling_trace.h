@@ -0,0 +1,393 @@
+// Trace ingestion for the scheduling core: CSV and binary columnar files.
+//
+// CSV traces have one process per line, "pid,arrival,burst[,priority]", with
+// an optional header line, blank lines and '#' comments. A numeric fourth
+// column is the priority (0 if absent); any other extra columns are ignored. The
+// file is read in fixed-size blocks and parsed with a hand-rolled number
+// parser straight into ProcessTable columns, one chunk of rows at a time.
+// With decimals > 0, arrival and burst may have up to that many fractional
+// digits and are stored as fixed-point ticks (99.99 at 2 decimals is 9999),
+// usually in a BasicProcessTable<int64_t>.
+//
+// Binary traces are a 32-byte header followed by the pid, arrival, burst and
+// priority columns stored back to back as little-endian int32 (files written
+// before priorities existed have only the first three). MappedTrace maps such a
+// file and hands the engines a ProcessView that points into the mapping, so a
+// multi-GB trace is paged in by the OS instead of being copied. Opening one
+// reads the arrival and burst columns once to reject what the CSV reader
+// rejects (negative times), and traces of more than INT32_MAX rows.
+#ifndef SCHEDULING_TRACE_H
+#define SCHEDULING_TRACE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "scheduling_core.h"
+
+// Binary trace header (the columns follow immediately after it)
+struct TraceHeader {
+    char magic[8];              // "SCHDTRC\0"
+    uint32_t version;           // TRACE_VERSION
+    uint32_t columns;           // Number of int32 columns (pid, arrival, burst[, priority])
+    uint64_t rows;              // Number of processes
+    uint64_t reserved;          // Zero
+};
+
+static const char TRACE_MAGIC[8] = {'S', 'C', 'H', 'D', 'T', 'R', 'C', '\0'};
+static const uint32_t TRACE_VERSION = 1;
+static const uint32_t TRACE_COLUMNS = 4;
+static const uint32_t TRACE_COLUMNS_NO_PRIORITY = 3;
+
+// Parse "[-]digits[.digits]" from [p, end) as a value scaled by 10^decimals
+// Returns the position after the number, or nullptr if there is no number or
+// it has more fractional precision than decimals allows
+inline const char* parseScaled(const char* p, const char* end, int decimals, int64_t& out) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+    const char* digits = p;
+    int64_t value = 0;
+    while (p < end && unsigned(*p - '0') < 10) {
+        // Longer than int64 can hold once scaled
+        if (p - digits + decimals >= 18) return nullptr;
+        value = value * 10 + (*p++ - '0');
+    }
+    bool has_integer = p != digits;
+
+    int scale = 0;
+    bool has_fraction = false;
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && unsigned(*p - '0') < 10) {
+            has_fraction = true;
+            if (scale < decimals) {
+                value = value * 10 + (*p - '0');
+                scale++;
+            } else if (*p != '0') {
+                // More precision than the requested resolution
+                return nullptr;
+            }
+            p++;
+        }
+    }
+    if (!has_integer && !has_fraction) return nullptr;
+    for (; scale < decimals; scale++) value *= 10;
+    out = negative ? -value : value;
+    return p;
+}
+
+// Streaming CSV reader that fills ProcessTable chunks
+class CsvTraceReader {
+public:
+    explicit CsvTraceReader(const std::string& path, int decimals = 0, size_t buffer_size = 1 << 20)
+        : path(path), decimals(decimals), buffer(buffer_size) {
+        file = std::fopen(path.c_str(), "rb");
+        if (!file) throw std::runtime_error("cannot open trace " + path);
+    }
+    ~CsvTraceReader() { if (file) std::fclose(file); }
+    CsvTraceReader(const CsvTraceReader&) = delete;
+    CsvTraceReader& operator=(const CsvTraceReader&) = delete;
+
+    // Replace chunk with up to max_rows rows; returns false once the file is
+    // exhausted and no rows were read
+    template <typename Time>
+    bool next(BasicProcessTable<Time>& chunk, size_t max_rows = 1 << 16) {
+        chunk.clear();
+        const char* line;
+        const char* line_end;
+        while (chunk.size() < max_rows && readLine(line, line_end)) {
+            parseLine(line, line_end, chunk);
+        }
+        return chunk.size() > 0;
+    }
+
+    // 1-based number of the last line read, for error messages
+    size_t lineNumber() const { return line_no; }
+
+private:
+    std::string path;
+    int decimals;               // Fractional digits of arrival and burst
+    FILE* file = nullptr;
+    std::vector<char> buffer;
+    size_t begin = 0;           // Start of unparsed data in buffer
+    size_t end = 0;             // End of valid data in buffer
+    bool eof = false;
+    size_t line_no = 0;
+
+    // Move unparsed bytes to the front of the buffer and read more after them
+    void fill() {
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+        // A line longer than the buffer: grow instead of splitting it
+        if (end == buffer.size()) buffer.resize(buffer.size() * 2);
+        size_t got = std::fread(buffer.data() + end, 1, buffer.size() - end, file);
+        end += got;
+        if (got == 0) eof = true;
+    }
+
+    bool readLine(const char*& line, const char*& line_end) {
+        for (;;) {
+            const char* start = buffer.data() + begin;
+            const char* nl = static_cast<const char*>(std::memchr(start, '\n', end - begin));
+            if (nl) {
+                line = start;
+                line_end = nl;
+                begin = nl - buffer.data() + 1;
+                line_no++;
+                return true;
+            }
+            if (eof) {
+                // Last line without a trailing newline
+                if (begin == end) return false;
+                line = start;
+                line_end = buffer.data() + end;
+                begin = end;
+                line_no++;
+                return true;
+            }
+            fill();
+        }
+    }
+
+    template <typename Time>
+    void parseLine(const char* p, const char* end, BasicProcessTable<Time>& chunk) {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        while (end > p && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t')) end--;
+        if (p == end || *p == '#') return;
+
+        int64_t field[3];
+        for (int f = 0; f < 3; f++) {
+            while (p < end && (*p == ' ' || *p == '\t')) p++;
+            // Only the times are fixed-point; the pid is always a whole number
+            int digits = f == 0 ? 0 : decimals;
+            const char* after = parseScaled(p, end, digits, field[f]);
+            if (!after) {
+                // A non-numeric first line is the header
+                if (line_no == 1 && f == 0) return;
+                if (digits == 0) fail("expected an integer in column " + std::to_string(f + 1));
+                fail("expected a number with at most " + std::to_string(digits) + " decimals in column " +
+                     std::to_string(f + 1));
+            }
+            p = after;
+            while (p < end && (*p == ' ' || *p == '\t')) p++;
+            if (f < 2) {
+                if (p == end || *p != ',') fail("expected pid,arrival,burst");
+                p++;
+            } else if (p != end && *p != ',') {
+                fail("unexpected text after burst time");
+            }
+            if (f == 0 ? field[f] < INT32_MIN || field[f] > INT32_MAX
+                       : field[f] < std::numeric_limits<Time>::min() || field[f] > std::numeric_limits<Time>::max()) {
+                fail("value does not fit in " + std::to_string(f == 0 ? 32 : 8 * sizeof(Time)) + " bits");
+            }
+        }
+        if (field[1] < 0 || field[2] < 0) fail("arrival and burst times must not be negative");
+
+        // Optional priority column
+        int64_t priority = 0;
+        if (p < end) {
+            p++;
+            while (p < end && (*p == ' ' || *p == '\t')) p++;
+            const char* after = parseScaled(p, end, 0, priority);
+            while (after && after < end && (*after == ' ' || *after == '\t')) after++;
+            if (!after || (after != end && *after != ',')) priority = 0;
+            else if (priority < INT32_MIN || priority > INT32_MAX) fail("value does not fit in 32 bits");
+        }
+        chunk.add(field[0], field[1], field[2], priority);
+    }
+
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error(path + ":" + std::to_string(line_no) + ": " + what);
+    }
+};
+
+// Load a whole CSV trace into a ProcessTable, or with decimals > 0 into a
+// fixed-point table such as BasicProcessTable<int64_t>
+template <typename Time = int32_t>
+BasicProcessTable<Time> loadCsvTrace(const std::string& path, int decimals = 0) {
+    CsvTraceReader reader(path, decimals);
+    BasicProcessTable<Time> table, chunk;
+    while (reader.next(chunk)) {
+        table.pid.insert(table.pid.end(), chunk.pid.begin(), chunk.pid.end());
+        table.arrival_time.insert(table.arrival_time.end(), chunk.arrival_time.begin(), chunk.arrival_time.end());
+        table.burst_time.insert(table.burst_time.end(), chunk.burst_time.begin(), chunk.burst_time.end());
+        table.priority.insert(table.priority.end(), chunk.priority.begin(), chunk.priority.end());
+    }
+    return table;
+}
+
+// Writes a binary trace whose row count is known up front
+// Chunks are appended column by column at their final offsets, so the writer
+// only ever holds one chunk in memory.
+class BinaryTraceWriter {
+public:
+    BinaryTraceWriter(const std::string& path, uint64_t rows) : path(path), rows(rows) {
+        file = std::fopen(path.c_str(), "wb");
+        if (!file) throw std::runtime_error("cannot create trace " + path);
+        TraceHeader header = {};
+        std::memcpy(header.magic, TRACE_MAGIC, sizeof header.magic);
+        header.version = TRACE_VERSION;
+        header.columns = TRACE_COLUMNS;
+        header.rows = rows;
+        write(0, &header, sizeof header);
+    }
+    ~BinaryTraceWriter() { if (file) std::fclose(file); }
+    BinaryTraceWriter(const BinaryTraceWriter&) = delete;
+    BinaryTraceWriter& operator=(const BinaryTraceWriter&) = delete;
+
+    // Append rows from a view; a view without priorities writes zeros
+    void append(const ProcessView& chunk) {
+        if (written + chunk.size() > rows) throw std::runtime_error(path + ": more rows than declared");
+        std::vector<int32_t> zeros;
+        if (!chunk.priority) zeros.assign(chunk.size(), 0);
+        const int32_t* columns[TRACE_COLUMNS] = {chunk.pid, chunk.arrival_time, chunk.burst_time,
+                                                 chunk.priority ? chunk.priority : zeros.data()};
+        for (uint32_t c = 0; c < TRACE_COLUMNS; c++) {
+            write(columnOffset(c) + written * sizeof(int32_t), columns[c], chunk.size() * sizeof(int32_t));
+        }
+        written += chunk.size();
+    }
+
+    // Flush and close; throws if fewer rows than declared were written
+    void close() {
+        if (written != rows) throw std::runtime_error(path + ": fewer rows than declared");
+        if (std::fclose(file) != 0) {
+            file = nullptr;
+            throw std::runtime_error("cannot write trace " + path);
+        }
+        file = nullptr;
+    }
+
+private:
+    std::string path;
+    FILE* file = nullptr;
+    uint64_t rows;
+    uint64_t written = 0;
+
+    uint64_t columnOffset(uint32_t c) const { return sizeof(TraceHeader) + c * rows * sizeof(int32_t); }
+
+    void write(uint64_t offset, const void* data, size_t bytes) {
+        if (fseeko(file, offset, SEEK_SET) != 0 || std::fwrite(data, 1, bytes, file) != bytes) {
+            throw std::runtime_error("cannot write trace " + path);
+        }
+    }
+};
+
+// Write a whole table as a binary trace
+inline void writeBinaryTrace(const std::string& path, const ProcessView& table) {
+    BinaryTraceWriter writer(path, table.size());
+    writer.append(table);
+    writer.close();
+}
+
+// Count the data rows of a CSV trace (a parse-only pass, so headers, blank
+// lines and comments are not counted)
+inline uint64_t countCsvRows(const std::string& path) {
+    CsvTraceReader reader(path);
+    ProcessTable chunk;
+    uint64_t rows = 0;
+    while (reader.next(chunk)) rows += chunk.size();
+    return rows;
+}
+
+// Convert a CSV trace to the binary format chunk by chunk
+inline void convertCsvToBinary(const std::string& csv_path, const std::string& binary_path) {
+    BinaryTraceWriter writer(binary_path, countCsvRows(csv_path));
+    CsvTraceReader reader(csv_path);
+    ProcessTable chunk;
+    while (reader.next(chunk)) writer.append(chunk);
+    writer.close();
+}
+
+// Read-only memory mapping of a binary trace
+class MappedTrace {
+public:
+    explicit MappedTrace(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open trace " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(TraceHeader)) {
+            ::close(fd);
+            throw std::runtime_error(path + ": not a binary trace");
+        }
+        length = st.st_size;
+        data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            data = nullptr;
+            throw std::runtime_error("cannot map trace " + path);
+        }
+        // The engines read the columns front to back
+        madvise(data, length, MADV_SEQUENTIAL);
+
+        const TraceHeader* header = static_cast<const TraceHeader*>(data);
+        uint64_t rows = header->rows;
+        if (std::memcmp(header->magic, TRACE_MAGIC, sizeof TRACE_MAGIC) != 0 ||
+            header->version != TRACE_VERSION ||
+            (header->columns != TRACE_COLUMNS && header->columns != TRACE_COLUMNS_NO_PRIORITY) ||
+            rows > (length - sizeof(TraceHeader)) / (header->columns * sizeof(int32_t))) {
+            unmap();
+            throw std::runtime_error(path + ": not a binary trace");
+        }
+        // The engines index rows with int
+        if (rows > INT32_MAX) {
+            unmap();
+            throw std::runtime_error(path + ": more than " + std::to_string(INT32_MAX) + " rows");
+        }
+        const int32_t* columns = reinterpret_cast<const int32_t*>(header + 1);
+        columns_view.pid = columns;
+        columns_view.arrival_time = columns + rows;
+        columns_view.burst_time = columns + 2 * rows;
+        if (header->columns == TRACE_COLUMNS) columns_view.priority = columns + 3 * rows;
+        columns_view.rows = rows;
+        validate(path);
+    }
+    ~MappedTrace() { unmap(); }
+    MappedTrace(const MappedTrace&) = delete;
+    MappedTrace& operator=(const MappedTrace&) = delete;
+
+    const ProcessView& view() const { return columns_view; }
+
+private:
+    void* data = nullptr;
+    size_t length = 0;
+    ProcessView columns_view;
+
+    void unmap() {
+        if (data) munmap(data, length);
+        data = nullptr;
+    }
+
+    // Refuse the values the CSV reader refuses (rows count from 1)
+    void validate(const std::string& path) {
+        for (size_t i = 0; i < columns_view.rows; i++) {
+            if (columns_view.arrival_time[i] < 0 || columns_view.burst_time[i] < 0) {
+                unmap();
+                throw std::runtime_error(path + ": row " + std::to_string(i + 1) +
+                                         ": arrival and burst times must not be negative");
+            }
+        }
+    }
+};
+
+// True if path starts with the binary trace magic
+inline bool isBinaryTrace(const std::string& path) {
+    char magic[sizeof TRACE_MAGIC] = {};
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    size_t got = std::fread(magic, 1, sizeof magic, file);
+    std::fclose(file);
+    return got == sizeof magic && std::memcmp(magic, TRACE_MAGIC, sizeof magic) == 0;
+}
+
+#endif
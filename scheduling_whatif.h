@@ -0,0 +1,400 @@
+// Incremental what-if re-simulation for sjf(), srtf() and roundRobin().
+//
+// A WhatIfSimulator runs the baseline schedule once with a resumable copy of
+// the engine's dispatch loop and keeps checkpoints of the loop state along the
+// way. A what-if query changes one job (or inserts a new one) without touching
+// the baseline: it resumes from the last checkpoint taken before the job could
+// first matter, i.e. before the earlier of its old and new arrival times, and
+// replays only until the loop state equals the baseline's at one of its
+// checkpoints again. From that point the two schedules are identical, so only
+// the completions seen during the replay can differ.
+#ifndef SCHEDULING_WHATIF_H
+#define SCHEDULING_WHATIF_H
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "scheduling_core.h"
+
+enum class ReplayPolicy { SJF, SRTF, RR };
+
+// Policy by short name ("sjf", "srtf" or "rr"); throws if unknown
+inline ReplayPolicy replayPolicyByName(const std::string& name) {
+    if (name == "sjf") return ReplayPolicy::SJF;
+    if (name == "srtf") return ReplayPolicy::SRTF;
+    if (name == "rr") return ReplayPolicy::RR;
+    throw std::invalid_argument("what-if does not support policy '" + name + "'");
+}
+
+// CT/TAT/WT of one row before and after a what-if change
+struct RowDelta {
+    int32_t row;
+    int32_t pid;
+    bool inserted;                      // New job: the "before" values are 0
+    int32_t completion_before, completion_after;
+    int32_t turnaround_before, turnaround_after;
+    int32_t waiting_before, waiting_after;
+};
+
+struct WhatIfDiff {
+    std::vector<RowDelta> rows;         // Rows whose CT/TAT/WT changed, changed job first
+    double average_waiting_before = 0, average_waiting_after = 0;
+    double average_turnaround_before = 0, average_turnaround_after = 0;
+    int64_t context_switches_before = 0, context_switches_after = 0;
+    int32_t resumed_at = 0;             // Time of the checkpoint the replay started from
+    int32_t converged_at = -1;          // Time the schedule matched the baseline again, -1 if never
+    int64_t replayed_steps = 0;         // Dispatches simulated for this query
+    int64_t total_steps = 0;            // Dispatches of the whole baseline run
+};
+
+// State at the top of the dispatch loop, which is all a run needs to resume
+struct ReplayState {
+    struct Job {
+        int32_t row;
+        int32_t remaining;
+    };
+    int64_t steps = 0;                  // Dispatches so far
+    int32_t time = 0;
+    int32_t next = 0;                   // Arrivals admitted so far
+    int32_t last_row = -1;
+    int64_t context_switches = 0;
+    int64_t switch_overhead = 0;
+    std::deque<Job> ready;              // Binary heap for SJF/SRTF, FIFO for RR
+};
+
+// The sjf(), srtf() and roundRobin() loops as a resumable step function
+// Input reads go through at()/bt()/pidOf() so one row can be overridden (or
+// one row appended) without copying the table, and arrivals come from the
+// baseline arrival order with that row merged in at its new position.
+class ReplayEngine {
+public:
+    ReplayState state;
+
+    ReplayEngine(ReplayPolicy policy, const ProcessView& table, const std::vector<int32_t>& order, int quantum,
+                 int switch_cost)
+        : policy(policy), table(table), order(order), quantum(quantum), switch_cost(switch_cost) {}
+
+    // Read row's pid/arrival/burst from the arguments instead of the table
+    // (row == table.size() appends a new job)
+    void override(int32_t row, int32_t pid, int32_t arrival, int32_t burst) {
+        changed_row = row;
+        changed_pid = pid;
+        changed_at = arrival;
+        changed_bt = burst;
+    }
+
+    // Continue from a checkpoint taken before the overridden row was admitted
+    void restore(const ReplayState& checkpoint) {
+        state = checkpoint;
+        base_next = checkpoint.next;
+        changed_emitted = false;
+    }
+
+    bool done() const { return peek() < 0 && state.ready.empty(); }
+    bool changedQueued() const {
+        for (const auto& job : state.ready) if (job.row == changed_row) return true;
+        return false;
+    }
+    bool changedAdmitted() const { return changed_emitted; }
+
+    int32_t at(int32_t row) const { return row == changed_row ? changed_at : table.arrival_time[row]; }
+    int32_t bt(int32_t row) const { return row == changed_row ? changed_bt : table.burst_time[row]; }
+    int32_t pidOf(int32_t row) const { return row == changed_row ? changed_pid : table.pid[row]; }
+
+    // One dispatch; completions are appended to completions as (row, CT)
+    void step(std::vector<std::pair<int32_t, int32_t>>& completions) {
+        // If nothing is waiting, jump to the next arrival time
+        int32_t arrival = peek();
+        if (state.ready.empty() && at(arrival) > state.time) state.time = at(arrival);
+        admit(state.time);
+
+        ReplayState::Job job = pop();
+        int32_t latency = dispatch(job.row);
+        state.time += latency;
+        state.steps++;
+
+        if (policy == ReplayPolicy::SJF) {
+            state.time += job.remaining;
+            completions.push_back({job.row, state.time});
+            return;
+        }
+        if (policy == ReplayPolicy::SRTF) {
+            // Queue whatever arrived while switching
+            if (latency > 0) admit(state.time);
+            // Run until it completes or the next process arrives
+            int32_t run_until = state.time + job.remaining;
+            arrival = peek();
+            if (arrival >= 0 && at(arrival) < run_until) run_until = at(arrival);
+            job.remaining -= run_until - state.time;
+            state.time = run_until;
+        } else {
+            int32_t execute_time = std::min(quantum, job.remaining);
+            state.time += execute_time;
+            job.remaining -= execute_time;
+            // Newly arrived processes go in before the preempted one
+            admit(state.time);
+        }
+        if (job.remaining == 0) completions.push_back({job.row, state.time});
+        else push(job);
+    }
+
+private:
+    ReplayPolicy policy;
+    ProcessView table;
+    const std::vector<int32_t>& order;
+    int quantum;
+    int switch_cost;
+    int32_t changed_row = -1;
+    int32_t changed_pid = 0, changed_at = 0, changed_bt = 0;
+    size_t base_next = 0;               // Position in the baseline arrival order
+    bool changed_emitted = false;
+    std::vector<int32_t> batch;
+
+    // Next row to arrive, or -1 if none is left
+    int32_t peek() const {
+        size_t i = base_next;
+        while (i < order.size() && order[i] == changed_row) i++;
+        int32_t row = i < order.size() ? order[i] : -1;
+        if (changed_row >= 0 && !changed_emitted &&
+            (row < 0 || changed_at < at(row) || (changed_at == at(row) && changed_row < row))) {
+            return changed_row;
+        }
+        return row;
+    }
+
+    void take(int32_t row) {
+        if (row == changed_row) {
+            changed_emitted = true;
+        } else {
+            while (order[base_next] == changed_row) base_next++;
+            base_next++;
+        }
+        state.next++;
+    }
+
+    // Admit every arrival up to t (RR enqueues each batch in row order)
+    void admit(int32_t t) {
+        batch.clear();
+        for (int32_t row = peek(); row >= 0 && at(row) <= t; row = peek()) {
+            take(row);
+            batch.push_back(row);
+        }
+        if (policy == ReplayPolicy::RR) std::sort(batch.begin(), batch.end());
+        for (int32_t row : batch) push({row, bt(row)});
+    }
+
+    // True if a should run after b (heap order)
+    bool after(const ReplayState::Job& a, const ReplayState::Job& b) const {
+        if (policy == ReplayPolicy::SRTF) {
+            return a.remaining != b.remaining ? a.remaining > b.remaining : a.row > b.row;
+        }
+        // SJF: (burst, arrival, pid, row) like sjf()
+        if (bt(a.row) != bt(b.row)) return bt(a.row) > bt(b.row);
+        if (at(a.row) != at(b.row)) return at(a.row) > at(b.row);
+        if (pidOf(a.row) != pidOf(b.row)) return pidOf(a.row) > pidOf(b.row);
+        return a.row > b.row;
+    }
+
+    void push(const ReplayState::Job& job) {
+        state.ready.push_back(job);
+        if (policy != ReplayPolicy::RR) {
+            std::push_heap(state.ready.begin(), state.ready.end(),
+                           [this](const ReplayState::Job& a, const ReplayState::Job& b) { return after(a, b); });
+        }
+    }
+
+    ReplayState::Job pop() {
+        if (policy == ReplayPolicy::RR) {
+            ReplayState::Job job = state.ready.front();
+            state.ready.pop_front();
+            return job;
+        }
+        std::pop_heap(state.ready.begin(), state.ready.end(),
+                      [this](const ReplayState::Job& a, const ReplayState::Job& b) { return after(a, b); });
+        ReplayState::Job job = state.ready.back();
+        state.ready.pop_back();
+        return job;
+    }
+
+    // Same switch accounting as ScheduleResult::dispatch()
+    int32_t dispatch(int32_t row) {
+        bool switched = state.last_row >= 0 && state.last_row != row;
+        state.last_row = row;
+        if (!switched) return 0;
+        state.context_switches++;
+        state.switch_overhead += switch_cost;
+        return switch_cost;
+    }
+};
+
+// Baseline schedule plus checkpoints, answering one-job what-if queries
+class WhatIfSimulator {
+public:
+    // checkpoint_interval is the minimum number of dispatches between
+    // checkpoints; a checkpoint also waits until at least as many dispatches
+    // as it has queued jobs have passed, so copying the queue never costs
+    // more than simulating did
+    WhatIfSimulator(const ProcessView& table, ReplayPolicy policy, int quantum = 1, int switch_cost = 0,
+                    int64_t checkpoint_interval = 1024)
+        : table(table), policy(policy), quantum(std::max(quantum, 1)), switch_cost(switch_cost),
+          order(arrivalOrder(table)), baseline(table.size()) {
+        ReplayEngine engine(policy, table, order, this->quantum, switch_cost);
+        std::vector<std::pair<int32_t, int32_t>> completions;
+        checkpoints.push_back(engine.state);
+        while (!engine.done()) {
+            const ReplayState& last = checkpoints.back();
+            if (engine.state.steps - last.steps >= std::max<int64_t>(checkpoint_interval, engine.state.ready.size())) {
+                checkpoints.push_back(engine.state);
+            }
+            engine.step(completions);
+            for (const auto& c : completions) baseline.complete(table, c.first, c.second);
+            completions.clear();
+        }
+        baseline.context_switches = engine.state.context_switches;
+        baseline.switch_overhead = engine.state.switch_overhead;
+        total_steps = engine.state.steps;
+        for (size_t i = 0; i < table.size(); i++) {
+            total_waiting += baseline.waiting_time[i];
+            total_turnaround += baseline.turnaround_time[i];
+        }
+    }
+
+    const ScheduleResult& result() const { return baseline; }
+    size_t checkpointCount() const { return checkpoints.size(); }
+
+    // Schedule with row's arrival and burst changed
+    WhatIfDiff modify(int32_t row, int32_t arrival, int32_t burst) const {
+        if (row < 0 || size_t(row) >= table.size()) throw std::out_of_range("what-if row out of range");
+        return evaluate(row, table.pid[row], arrival, burst);
+    }
+
+    // Schedule with one more job appended to the trace
+    WhatIfDiff insert(int32_t pid, int32_t arrival, int32_t burst) const {
+        return evaluate(table.size(), pid, arrival, burst);
+    }
+
+private:
+    ProcessView table;
+    ReplayPolicy policy;
+    int quantum;
+    int switch_cost;
+    std::vector<int32_t> order;
+    ScheduleResult baseline;
+    std::vector<ReplayState> checkpoints;   // In step (and time) order
+    int64_t total_steps = 0;
+    int64_t total_waiting = 0;
+    int64_t total_turnaround = 0;
+
+    // Sorted (row, remaining) pairs of a heap, for comparing as a set
+    static std::vector<std::pair<int32_t, int32_t>> sortedJobs(const std::deque<ReplayState::Job>& ready) {
+        std::vector<std::pair<int32_t, int32_t>> jobs;
+        jobs.reserve(ready.size());
+        for (const auto& job : ready) jobs.push_back({job.row, job.remaining});
+        std::sort(jobs.begin(), jobs.end());
+        return jobs;
+    }
+
+    // True once the replay's future is the baseline's future from checkpoint:
+    // both versions of the changed job are finished and the queues match
+    bool converged(const ReplayEngine& replay, const ReplayState& checkpoint, int32_t row, bool inserted,
+                   size_t old_position) const {
+        const ReplayState& s = replay.state;
+        if (s.time != checkpoint.time || s.last_row != checkpoint.last_row ||
+            s.next != checkpoint.next + (inserted ? 1 : 0) || s.ready.size() != checkpoint.ready.size()) {
+            return false;
+        }
+        if (!replay.changedAdmitted() || replay.changedQueued()) return false;
+        if (!inserted) {
+            if (size_t(checkpoint.next) <= old_position) return false;
+            for (const auto& job : checkpoint.ready) if (job.row == row) return false;
+        }
+        if (policy == ReplayPolicy::RR) {
+            for (size_t i = 0; i < s.ready.size(); i++) {
+                if (s.ready[i].row != checkpoint.ready[i].row || s.ready[i].remaining != checkpoint.ready[i].remaining) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return sortedJobs(s.ready) == sortedJobs(checkpoint.ready);
+    }
+
+    WhatIfDiff evaluate(int32_t row, int32_t pid, int32_t arrival, int32_t burst) const {
+        if (arrival < 0 || burst < 0) throw std::invalid_argument("arrival and burst times must not be negative");
+        bool inserted = size_t(row) == table.size();
+        size_t n = table.size();
+
+        // Resume from the last checkpoint before either version can arrive
+        int32_t first_effect = inserted ? arrival : std::min(arrival, table.arrival_time[row]);
+        size_t k = std::partition_point(checkpoints.begin(), checkpoints.end(), [first_effect](const ReplayState& c) {
+                       return c.time < first_effect;
+                   }) - checkpoints.begin();
+        k = k > 0 ? k - 1 : 0;
+
+        // Position of the old version in the baseline arrival order
+        size_t old_position = 0;
+        if (!inserted) old_position = std::find(order.begin() + checkpoints[k].next, order.end(), row) - order.begin();
+
+        ReplayEngine replay(policy, table, order, quantum, switch_cost);
+        replay.override(row, pid, arrival, burst);
+        replay.restore(checkpoints[k]);
+
+        WhatIfDiff diff;
+        diff.resumed_at = checkpoints[k].time;
+        diff.total_steps = total_steps;
+        std::vector<std::pair<int32_t, int32_t>> completions;
+        size_t c = k + 1;
+        int64_t switches_after = -1;
+        while (!replay.done()) {
+            replay.step(completions);
+            // Compare against the baseline checkpoints at the same time
+            while (c < checkpoints.size() && checkpoints[c].time < replay.state.time) c++;
+            for (size_t j = c; j < checkpoints.size() && checkpoints[j].time == replay.state.time; j++) {
+                if (converged(replay, checkpoints[j], row, inserted, old_position)) {
+                    diff.converged_at = replay.state.time;
+                    switches_after = baseline.context_switches + replay.state.context_switches - checkpoints[j].context_switches;
+                    break;
+                }
+            }
+            if (diff.converged_at >= 0) break;
+        }
+        diff.replayed_steps = replay.state.steps - checkpoints[k].steps;
+        diff.context_switches_before = baseline.context_switches;
+        diff.context_switches_after = switches_after >= 0 ? switches_after : replay.state.context_switches;
+
+        // Only rows completed during the replay can differ from the baseline
+        int64_t waiting = total_waiting, turnaround = total_turnaround;
+        for (const auto& done : completions) {
+            int32_t r = done.first, ct = done.second;
+            RowDelta delta = {r, replay.pidOf(r), inserted && r == row, 0, ct, 0, ct - replay.at(r), 0,
+                              ct - replay.at(r) - replay.bt(r)};
+            if (!delta.inserted) {
+                delta.completion_before = baseline.completion_time[r];
+                delta.turnaround_before = baseline.turnaround_time[r];
+                delta.waiting_before = baseline.waiting_time[r];
+            }
+            if (r != row && delta.completion_before == delta.completion_after) continue;
+            waiting += delta.waiting_after - delta.waiting_before;
+            turnaround += delta.turnaround_after - delta.turnaround_before;
+            diff.rows.push_back(delta);
+        }
+        std::stable_partition(diff.rows.begin(), diff.rows.end(), [row](const RowDelta& d) { return d.row == row; });
+        std::stable_sort(diff.rows.begin() + 1, diff.rows.end(), [](const RowDelta& a, const RowDelta& b) {
+            return a.row < b.row;
+        });
+
+        size_t after_rows = n + (inserted ? 1 : 0);
+        diff.average_waiting_before = n > 0 ? double(total_waiting) / n : 0;
+        diff.average_turnaround_before = n > 0 ? double(total_turnaround) / n : 0;
+        diff.average_waiting_after = double(waiting) / after_rows;
+        diff.average_turnaround_after = double(turnaround) / after_rows;
+        return diff;
+    }
+};
+
+#endif
@@ -0,0 +1,231 @@
+// Synthetic workload generator: reproducible traces at production scale.
+//
+// Rows are generated in fixed blocks of WORKLOAD_BLOCK jobs, and each block
+// draws from its own random stream derived from (seed, block index). Blocks
+// are spread over a thread pool, so a trace is bit-identical for a given seed
+// whatever the number of threads. Arrival gaps are summed inside each block
+// first; a serial prefix sum over the block spans then shifts every block to
+// its start time. The transforms are hand-rolled rather than taken from
+// <random>, whose distributions differ between standard libraries.
+#ifndef SCHEDULING_WORKLOAD_H
+#define SCHEDULING_WORKLOAD_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "scheduling_core.h"
+#include "scheduling_parallel.h"
+#include "scheduling_trace.h"
+
+// Jobs per random stream; changing it changes every generated trace
+static const size_t WORKLOAD_BLOCK = 1 << 16;
+
+enum class ArrivalPattern {
+    Uniform,        // Gaps uniform in [0, 2 * mean gap]
+    Poisson,        // Exponential gaps
+    Bursty          // Poisson groups of ~group_size jobs arriving together
+};
+
+enum class BurstDistribution {
+    Uniform,        // Uniform in [1, 2 * mean - 1]
+    Exponential,
+    Pareto,         // Heavy tail with shape pareto_alpha
+    Bimodal         // Mostly short jobs plus a few long ones
+};
+
+// Parameters of a synthetic trace; means are in time units
+struct WorkloadSpec {
+    size_t jobs = 1000;
+    ArrivalPattern arrivals = ArrivalPattern::Poisson;
+    BurstDistribution bursts = BurstDistribution::Exponential;
+    double mean_burst = 10;
+    double load = 0.9;                  // Mean burst over mean arrival gap
+    double pareto_alpha = 1.5;          // Must be > 1 for a finite mean
+    double group_size = 50;             // Mean jobs per group of bursty arrivals
+    double bimodal_long_share = 0.1;    // Share of long jobs in a bimodal mix
+    double bimodal_ratio = 20;          // Long job mean over short job mean
+    int priority_levels = 0;            // Priorities uniform in [0, levels); 0 = all 0
+    uint64_t seed = 1;
+};
+
+// Short names, as used on the command line
+inline ArrivalPattern arrivalPatternByName(const std::string& name) {
+    if (name == "uniform") return ArrivalPattern::Uniform;
+    if (name == "poisson") return ArrivalPattern::Poisson;
+    if (name == "bursty") return ArrivalPattern::Bursty;
+    throw std::invalid_argument("unknown arrival pattern '" + name + "'");
+}
+
+inline BurstDistribution burstDistributionByName(const std::string& name) {
+    if (name == "uniform") return BurstDistribution::Uniform;
+    if (name == "exponential") return BurstDistribution::Exponential;
+    if (name == "pareto") return BurstDistribution::Pareto;
+    if (name == "bimodal") return BurstDistribution::Bimodal;
+    throw std::invalid_argument("unknown burst distribution '" + name + "'");
+}
+
+// splitmix64 step, used to derive and seed the per-block streams
+inline uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256** generator: small state, so one per block is cheap
+class WorkloadRng {
+public:
+    WorkloadRng(uint64_t seed, uint64_t stream) {
+        uint64_t sm = seed ^ splitMix64(stream);
+        for (auto& word : s) word = splitMix64(sm);
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, 1)
+    double uniform() { return (next() >> 11) * 0x1.0p-53; }
+    // Exponential with the given mean
+    double exponential(double mean) { return -mean * std::log1p(-uniform()); }
+
+private:
+    uint64_t s[4];
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+// Fill rows [first, first + count) of the columns from block's stream
+// Arrival times are relative to the block start; returns the block's span
+inline int64_t generateBlock(const WorkloadSpec& spec, uint64_t block, size_t first, size_t count, int32_t* pid,
+                             int32_t* arrival, int32_t* burst, int32_t* priority) {
+    WorkloadRng rng(spec.seed, block);
+    double mean_gap = spec.mean_burst / spec.load;
+    // Pareto scale for the requested mean: x_m = mean * (alpha - 1) / alpha
+    double x_m = spec.mean_burst * (spec.pareto_alpha - 1) / spec.pareto_alpha;
+    // Bimodal means: share * long + (1 - share) * short = mean
+    double short_mean = spec.mean_burst / (1 + spec.bimodal_long_share * (spec.bimodal_ratio - 1));
+    double t = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        switch (spec.arrivals) {
+        case ArrivalPattern::Uniform: t += 2 * mean_gap * rng.uniform(); break;
+        case ArrivalPattern::Poisson: t += rng.exponential(mean_gap); break;
+        case ArrivalPattern::Bursty:
+            // A new group starts with probability 1 / group_size per job
+            if (rng.uniform() * spec.group_size < 1) t += rng.exponential(mean_gap * spec.group_size);
+            break;
+        }
+        // Checked before narrowing; generateRange() checks the sum of the spans
+        if (t > INT32_MAX) throw std::overflow_error("arrival times do not fit in 32 bits; lower the job count or load");
+        double bt = 0;
+        switch (spec.bursts) {
+        case BurstDistribution::Uniform: bt = 1 + (2 * spec.mean_burst - 2) * rng.uniform(); break;
+        case BurstDistribution::Exponential: bt = rng.exponential(spec.mean_burst); break;
+        case BurstDistribution::Pareto: bt = x_m / std::pow(1 - rng.uniform(), 1 / spec.pareto_alpha); break;
+        case BurstDistribution::Bimodal:
+            bt = rng.uniform() < spec.bimodal_long_share ? rng.exponential(short_mean * spec.bimodal_ratio)
+                                                         : rng.exponential(short_mean);
+            break;
+        }
+        pid[i] = first + i + 1;
+        arrival[i] = int32_t(t);
+        burst[i] = int32_t(std::min(std::max(std::round(bt), 1.0), 1e9));
+        priority[i] = spec.priority_levels > 0 ? int32_t(rng.uniform() * spec.priority_levels) : 0;
+    }
+    return int64_t(t);
+}
+
+// Generate rows [first, first + count) into table (resized to count rows)
+// first must be a multiple of WORKLOAD_BLOCK; start is the arrival time the
+// range begins at. Returns the arrival time the next range starts at.
+inline int64_t generateRange(ThreadPool& pool, const WorkloadSpec& spec, size_t first, size_t count,
+                             int64_t start, ProcessTable& table) {
+    table.pid.resize(count);
+    table.arrival_time.resize(count);
+    table.burst_time.resize(count);
+    table.priority.resize(count);
+    size_t blocks = (count + WORKLOAD_BLOCK - 1) / WORKLOAD_BLOCK;
+    std::vector<int64_t> spans(blocks);
+
+    // Generate blocks independently, a few per task
+    size_t per_task = std::max<size_t>(1, blocks / (4 * pool.size()));
+    std::vector<std::future<void>> pending;
+    for (size_t b0 = 0; b0 < blocks; b0 += per_task) {
+        pending.push_back(pool.submit([&, b0] {
+            for (size_t b = b0; b < std::min(blocks, b0 + per_task); b++) {
+                size_t offset = b * WORKLOAD_BLOCK, rows = std::min(WORKLOAD_BLOCK, count - offset);
+                spans[b] = generateBlock(spec, (first + offset) / WORKLOAD_BLOCK, first + offset, rows,
+                                         &table.pid[offset], &table.arrival_time[offset],
+                                         &table.burst_time[offset], &table.priority[offset]);
+            }
+        }));
+    }
+    for (auto& f : pending) f.get();
+
+    // Block start times are a prefix sum of the spans
+    std::vector<int64_t> starts(blocks);
+    for (size_t b = 0; b < blocks; b++) {
+        starts[b] = start;
+        start += spans[b];
+    }
+    if (start > INT32_MAX) throw std::overflow_error("arrival times do not fit in 32 bits; lower the job count or load");
+
+    // Shift each block to its start
+    pending.clear();
+    for (size_t b0 = 0; b0 < blocks; b0 += per_task) {
+        pending.push_back(pool.submit([&, b0] {
+            for (size_t b = b0; b < std::min(blocks, b0 + per_task); b++) {
+                int32_t shift = starts[b];
+                size_t end = std::min(count, (b + 1) * WORKLOAD_BLOCK);
+                for (size_t i = b * WORKLOAD_BLOCK; i < end; i++) table.arrival_time[i] += shift;
+            }
+        }));
+    }
+    for (auto& f : pending) f.get();
+    return start;
+}
+
+inline void checkSpec(const WorkloadSpec& spec) {
+    if (spec.mean_burst <= 0 || spec.load <= 0) throw std::invalid_argument("mean burst and load must be positive");
+    if (spec.pareto_alpha <= 1) throw std::invalid_argument("Pareto shape must be greater than 1");
+    if (spec.group_size < 1) throw std::invalid_argument("group size must be at least 1");
+}
+
+// Generate a whole trace into memory
+inline ProcessTable generateWorkload(const WorkloadSpec& spec, ThreadPool& pool) {
+    checkSpec(spec);
+    ProcessTable table;
+    generateRange(pool, spec, 0, spec.jobs, 0, table);
+    return table;
+}
+
+// Generate a trace straight into a binary trace file, a slice at a time, so
+// traces larger than memory can be written
+inline void writeWorkload(const std::string& path, const WorkloadSpec& spec, ThreadPool& pool,
+                          size_t slice_blocks = 256) {
+    checkSpec(spec);
+    BinaryTraceWriter writer(path, spec.jobs);
+    ProcessTable slice;
+    int64_t start = 0;
+    for (size_t first = 0; first < spec.jobs; first += slice_blocks * WORKLOAD_BLOCK) {
+        size_t count = std::min(slice_blocks * WORKLOAD_BLOCK, spec.jobs - first);
+        start = generateRange(pool, spec, first, count, start, slice);
+        writer.append(slice);
+    }
+    writer.close();
+}
+
+#endif